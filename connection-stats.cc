@@ -0,0 +1,95 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// Kommunikation in verteilten Systemen - Per connection accounting
+// The CountingSink counts every accepted connection separately, this only evaluates its counters.
+// Used to compare a striped transfer over parallel connections with a single connection.
+
+#include <algorithm>
+#include "ns3/log.h"
+#include "ns3/inet-socket-address.h"
+#include "connection-stats.h"
+
+namespace ns3 {
+
+    NS_LOG_COMPONENT_DEFINE ("ConnectionStats");
+
+    ConnectionStats::ConnectionStats()
+            : m_start(Seconds(0)) {
+    }
+
+    void
+    ConnectionStats::Install(Ptr<CountingSink> sink, Time start) {
+        m_sink = sink;
+        m_start = start;
+    }
+
+    double
+    ConnectionStats::GetThroughput(const CountingSink::Flow &flow) const {
+        return flow.last > m_start ? flow.rxBytes * 8 / (flow.last - m_start).GetSeconds() : 0.0;
+    }
+
+    void
+    ConnectionStats::PrintJson(std::ostream &os) const {
+        uint64_t rxBytes = 0;
+        Time completion = m_start;
+        double minThroughput = 0.0;
+        double maxThroughput = 0.0;
+        double sum = 0.0;
+        double sumSquares = 0.0;
+
+        const std::vector<CountingSink::Flow> &flows = m_sink->GetFlows();
+
+        os << "{\"connections\":[";
+        for (std::vector<CountingSink::Flow>::const_iterator i = flows.begin(); i != flows.end(); ++i) {
+            double throughput = GetThroughput(*i);
+            rxBytes += i->rxBytes;
+            completion = std::max(completion, i->last);
+            minThroughput = i == flows.begin() ? throughput : std::min(minThroughput, throughput);
+            maxThroughput = std::max(maxThroughput, throughput);
+            sum += throughput;
+            sumSquares += throughput * throughput;
+
+            if (i != flows.begin()) {
+                os << ",";
+            }
+            os << "{";
+            if (InetSocketAddress::IsMatchingType(i->peer)) {
+                InetSocketAddress address = InetSocketAddress::ConvertFrom(i->peer);
+                os << "\"from\":\"" << address.GetIpv4() << ":" << address.GetPort() << "\",";
+            }
+            os << "\"rx_bytes\":" << i->rxBytes << ",";
+            os << "\"rx_ms_first\":" << i->first.GetMilliSeconds() << ",";
+            os << "\"rx_ms_last\":" << i->last.GetMilliSeconds() << ",";
+            os << "\"throughput_bps\":" << throughput;
+            os << "}";
+        }
+        os << "],";
+
+        CountingSink::Flow total;
+        total.rxBytes = rxBytes;
+        total.last = completion;
+        os << "\"rx_bytes\":" << rxBytes << ",";
+        os << "\"completion_ms\":" << (completion - m_start).GetMilliSeconds() << ",";
+        os << "\"throughput_bps\":" << GetThroughput(total) << ",";
+        os << "\"min_throughput_bps\":" << minThroughput << ",";
+        os << "\"max_throughput_bps\":" << maxThroughput << ",";
+        // Jain's fairness index of the per connection throughputs (1: all connections got the same share)
+        os << "\"fairness\":" << (sumSquares > 0.0 ? sum * sum / (flows.size() * sumSquares) : 0.0);
+        os << "}";
+    }
+
+} // namespace ns3
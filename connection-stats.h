@@ -0,0 +1,65 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef CONNECTION_STATS_H
+#define CONNECTION_STATS_H
+
+#include <ostream>
+#include "ns3/nstime.h"
+#include "counting-sink.h"
+
+namespace ns3 {
+
+/**
+ * \brief Received bytes and completion time of every connection arriving at a CountingSink.
+ *
+ * Every flow counted by the sink is a connection. The throughput of a connection is measured from the start
+ * of the transfer to the last byte received over it, the aggregate throughput from
+ * the start to the last byte received over any connection (the completion time).
+ */
+    class ConnectionStats {
+    public:
+        ConnectionStats();
+
+        /**
+         * Report the flows of the sink.
+         *
+         * \param sink the CountingSink receiving the connections
+         * \param start the time the transfer starts
+         */
+        void Install(Ptr<CountingSink> sink, Time start);
+
+        /**
+         * Print the statistics of every connection and the aggregate as JSON object.
+         *
+         * \param os the stream to print to
+         */
+        void PrintJson(std::ostream &os) const;
+
+    private:
+        /**
+         * \param flow the counters of a connection
+         * \return the throughput of the connection in bit/s
+         */
+        double GetThroughput(const CountingSink::Flow &flow) const;
+
+        Ptr<CountingSink> m_sink;   //!< The sink counting the connections
+        Time m_start;               //!< Start of the transfer
+    };
+
+} // namespace ns3
+
+#endif /* CONNECTION_STATS_H */
@@ -0,0 +1,77 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef COUNTING_SINK_HELPER_H
+#define COUNTING_SINK_HELPER_H
+
+#include <string>
+#include "ns3/object-factory.h"
+#include "ns3/address.h"
+#include "ns3/attribute.h"
+#include "ns3/node-container.h"
+#include "ns3/application-container.h"
+
+namespace ns3 {
+
+/**
+ * \brief A helper to make it easier to instantiate an ns3::CountingSink
+ * on a set of nodes.
+ */
+    class CountingSinkHelper {
+    public:
+        /**
+         * Create a CountingSinkHelper to make it easier to work with CountingSinks
+         *
+         * \param protocol the name of the protocol to use to receive traffic.
+         *        This string identifies the socket factory type used to create
+         *        sockets for the applications. A typical value would be
+         *        ns3::TcpSocketFactory.
+         * \param address the address the sink listens on
+         */
+        CountingSinkHelper(std::string protocol, Address address);
+
+        /**
+         * Helper function used to set the underlying application attributes.
+         *
+         * \param name the name of the application attribute to set
+         * \param value the value of the application attribute to set
+         */
+        void SetAttribute(std::string name, const AttributeValue &value);
+
+        /**
+         * Install an ns3::CountingSink on each node of the input container.
+         *
+         * \param c NodeContainer of the set of nodes on which a CountingSink
+         * will be installed.
+         * \returns Container of Ptr to the applications installed.
+         */
+        ApplicationContainer Install(NodeContainer c) const;
+
+        /**
+         * Install an ns3::CountingSink on the node.
+         *
+         * \param node The node on which a CountingSink will be installed.
+         * \returns Container of Ptr to the applications installed.
+         */
+        ApplicationContainer Install(Ptr<Node> node) const;
+
+    private:
+        ObjectFactory m_factory; //!< Object factory.
+    };
+
+} // namespace ns3
+
+#endif /* COUNTING_SINK_HELPER_H */
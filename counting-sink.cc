@@ -0,0 +1,203 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// Kommunikation in verteilten Systemen - Counting sink
+// ns3's PacketSink reports every packet through its "Rx" trace, including the address of the sender. Connecting
+// a callback to it costs a call and an address copy per packet, even if only the totals are of interest.
+// This sink does the accounting itself. The receive callback of every socket is bound to the index of its flow,
+// so no lookup is needed either.
+// Checksumming needs the payload as contiguous bytes. Packets keep it in a chain of buffers, so it is copied
+// into one buffer, which is reused for all packets.
+
+#include "ns3/log.h"
+#include "ns3/address.h"
+#include "ns3/node.h"
+#include "ns3/socket.h"
+#include "ns3/simulator.h"
+#include "ns3/packet.h"
+#include "ns3/boolean.h"
+#include "ns3/udp-socket-factory.h"
+#include "counting-sink.h"
+
+namespace ns3 {
+
+    NS_LOG_COMPONENT_DEFINE ("CountingSink");
+
+    NS_OBJECT_ENSURE_REGISTERED (CountingSink);
+
+    TypeId
+    CountingSink::GetTypeId(void) {
+        static TypeId tid = TypeId("ns3::CountingSink")
+                .SetParent<Application>()
+                .SetGroupName("Applications")
+                .AddConstructor<CountingSink>()
+                .AddAttribute("Local", "The address on which to bind the socket.",
+                              AddressValue(),
+                              MakeAddressAccessor(&CountingSink::m_local),
+                              MakeAddressChecker())
+                .AddAttribute("Protocol", "The type id of the protocol to use for the rx socket.",
+                              TypeIdValue(UdpSocketFactory::GetTypeId()),
+                              MakeTypeIdAccessor(&CountingSink::m_tid),
+                              MakeTypeIdChecker())
+                .AddAttribute("Checksum", "Checksum the payload of every flow.",
+                              BooleanValue(false),
+                              MakeBooleanAccessor(&CountingSink::m_checksum),
+                              MakeBooleanChecker());
+        return tid;
+    }
+
+    CountingSink::CountingSink()
+            : m_socket(0),
+              m_checksum(false),
+              m_threshold(0) {
+        NS_LOG_FUNCTION (this);
+        m_total.rxBytes = 0;
+        m_total.rxPackets = 0;
+    }
+
+    CountingSink::~CountingSink() {
+        NS_LOG_FUNCTION (this);
+    }
+
+    const std::vector<CountingSink::Flow> &
+    CountingSink::GetFlows(void) const {
+        return m_flows;
+    }
+
+    const CountingSink::Flow &
+    CountingSink::GetTotal(void) const {
+        return m_total;
+    }
+
+    uint64_t
+    CountingSink::GetTotalRx(void) const {
+        return m_total.rxBytes;
+    }
+
+    void
+    CountingSink::SetThresholdCallback(uint64_t bytes, Callback<void, uint64_t> callback) {
+        m_threshold = bytes;
+        m_thresholdCallback = callback;
+    }
+
+    void
+    CountingSink::DoDispose(void) {
+        NS_LOG_FUNCTION (this);
+
+        // The counters stay available after the simulation has been destroyed
+        m_socket = 0;
+        m_accepted.clear();
+        m_thresholdCallback = MakeNullCallback<void, uint64_t>();
+        // chain up
+        Application::DoDispose();
+    }
+
+// Application Methods
+    void CountingSink::StartApplication(void) // Called at time specified by Start
+    {
+        NS_LOG_FUNCTION (this);
+
+        if (!m_socket) {
+            m_socket = Socket::CreateSocket(GetNode(), m_tid);
+            if (m_socket->Bind(m_local) == -1) {
+                NS_FATAL_ERROR ("Failed to bind socket");
+            }
+            m_socket->Listen();
+            m_socket->ShutdownSend();
+
+            if (m_socket->GetSocketType() != Socket::NS3_SOCK_STREAM &&
+                m_socket->GetSocketType() != Socket::NS3_SOCK_SEQPACKET) {
+                // No connections, all datagrams belong to one flow
+                AddFlow(m_socket, Address());
+            }
+        }
+        m_socket->SetAcceptCallback(
+                MakeNullCallback<bool, Ptr<Socket>, const Address &>(),
+                MakeCallback(&CountingSink::HandleAccept, this));
+    }
+
+    void CountingSink::StopApplication(void) // Called at time specified by Stop
+    {
+        NS_LOG_FUNCTION (this);
+
+        for (std::vector<Ptr<Socket> >::iterator i = m_accepted.begin(); i != m_accepted.end(); ++i) {
+            (*i)->Close();
+        }
+        if (m_socket) {
+            m_socket->Close();
+            m_socket->SetRecvCallback(MakeNullCallback<void, Ptr<Socket> >());
+        }
+    }
+
+// Private helpers
+
+    void CountingSink::AddFlow(Ptr<Socket> socket, const Address &peer) {
+        Flow flow;
+        flow.peer = peer;
+        flow.rxBytes = 0;
+        flow.rxPackets = 0;
+        m_flows.push_back(flow);
+        socket->SetRecvCallback(MakeBoundCallback(&CountingSink::HandleRead, this, (uint32_t) (m_flows.size() - 1)));
+    }
+
+    void CountingSink::HandleAccept(Ptr<Socket> socket, const Address &from) {
+        NS_LOG_FUNCTION (this << socket << from);
+        m_accepted.push_back(socket);
+        AddFlow(socket, from);
+    }
+
+    void CountingSink::HandleRead(CountingSink *sink, uint32_t flow, Ptr<Socket> socket) {
+        Flow &counters = sink->m_flows[flow];
+        Flow &total = sink->m_total;
+        Time now = Simulator::Now();
+
+        Ptr<Packet> packet;
+        while ((packet = socket->Recv())) {
+            uint32_t size = packet->GetSize();
+            if (size == 0) {
+                break;
+            }
+            if (counters.rxPackets == 0) {
+                counters.first = now;
+            }
+            if (total.rxPackets == 0) {
+                total.first = now;
+            }
+            if (sink->m_checksum) {
+                if (sink->m_buffer.size() < size) {
+                    sink->m_buffer.resize(size);
+                }
+                packet->CopyData(&sink->m_buffer[0], size);
+                counters.checksum.Update(&sink->m_buffer[0], size);
+            }
+            counters.rxBytes += size;
+            counters.rxPackets++;
+            counters.last = now;
+            total.rxBytes += size;
+            total.rxPackets++;
+            total.last = now;
+        }
+
+        if (sink->m_threshold > 0 && total.rxBytes >= sink->m_threshold) {
+            // Only call back once
+            sink->m_threshold = 0;
+            if (!sink->m_thresholdCallback.IsNull()) {
+                sink->m_thresholdCallback(total.rxBytes);
+            }
+        }
+    }
+
+} // Namespace ns3
@@ -0,0 +1,134 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef COUNTING_SINK_H
+#define COUNTING_SINK_H
+
+#include <vector>
+#include "ns3/address.h"
+#include "ns3/application.h"
+#include "ns3/callback.h"
+#include "ns3/nstime.h"
+#include "ns3/ptr.h"
+#include "payload-checksum.h"
+
+namespace ns3 {
+
+    class Socket;
+
+/**
+ * \ingroup applications
+ *
+ * \brief Receive traffic and count it per flow, without a per packet trace.
+ *
+ * A replacement of ns3's PacketSink for measurements: Every flow keeps its
+ * received bytes and packets and the time of its first and last packet.
+ * Every accepted TCP connection is a flow of its own. UDP datagrams are all
+ * accounted to a single flow, so the sender address of a datagram is never
+ * looked at.
+ *
+ * Instead of a callback for every packet, a callback can be registered which
+ * is called once, as soon as a given number of bytes has been received in total.
+ *
+ * If the Checksum attribute is set, the payload of every flow is checksummed
+ * in the order it is received. For TCP this is the reassembled byte stream, so
+ * the checksum can be compared to the one of the data the sender sent.
+ */
+    class CountingSink : public Application {
+    public:
+        /// Counters of a single flow
+        struct Flow {
+            Address peer;       //!< Address of the sender (empty for UDP)
+            uint64_t rxBytes;   //!< Bytes received
+            uint64_t rxPackets; //!< Packets received
+            Time first;         //!< Time the first packet was received
+            Time last;          //!< Time the last packet was received
+            PayloadChecksum checksum;   //!< Checksum of the bytes received (if enabled)
+        };
+
+        /**
+         * \brief Get the type ID.
+         * \return the object TypeId
+         */
+        static TypeId GetTypeId(void);
+
+        CountingSink();
+
+        virtual ~CountingSink();
+
+        /**
+         * \return the counters of every flow, in the order the flows started
+         */
+        const std::vector<Flow> &GetFlows(void) const;
+
+        /**
+         * \return the counters of all flows together (first and last packet of any flow)
+         */
+        const Flow &GetTotal(void) const;
+
+        /**
+         * \return the total number of bytes received
+         */
+        uint64_t GetTotalRx(void) const;
+
+        /**
+         * Call back once as soon as the given number of bytes has been received in total.
+         *
+         * \param bytes the number of bytes
+         * \param callback called with the number of bytes received so far
+         */
+        void SetThresholdCallback(uint64_t bytes, Callback<void, uint64_t> callback);
+
+    protected:
+        virtual void DoDispose(void);
+
+    private:
+        // inherited from Application base class.
+        virtual void StartApplication(void);    // Called at time specified by Start
+        virtual void StopApplication(void);     // Called at time specified by Stop
+
+        /**
+         * \brief Add a new flow.
+         * \param socket the socket the flow is received on
+         * \param peer the address of the sender
+         */
+        void AddFlow(Ptr<Socket> socket, const Address &peer);
+
+        /**
+         * \brief Receive callback of the socket of a flow.
+         * \param sink the application
+         * \param flow the index of the flow
+         * \param socket the socket
+         */
+        static void HandleRead(CountingSink *sink, uint32_t flow, Ptr<Socket> socket);
+
+        void HandleAccept(Ptr<Socket> socket, const Address &from); //!< Socket callback, connection accepted
+
+        Address m_local;                    //!< Local address to bind to
+        TypeId m_tid;                       //!< Protocol TypeId
+        Ptr<Socket> m_socket;               //!< Listening socket
+        std::vector<Ptr<Socket> > m_accepted;   //!< Accepted sockets
+        std::vector<Flow> m_flows;          //!< Counters of every flow
+        Flow m_total;                       //!< Counters of all flows together
+        bool m_checksum;                    //!< Checksum the payload of every flow
+        std::vector<uint8_t> m_buffer;      //!< Payload of the packet being checksummed
+        uint64_t m_threshold;               //!< Bytes after which m_thresholdCallback is called (0: never)
+        Callback<void, uint64_t> m_thresholdCallback;  //!< Called once the threshold has been reached
+    };
+
+} // namespace ns3
+
+#endif /* COUNTING_SINK_H */
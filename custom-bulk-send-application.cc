@@ -21,11 +21,15 @@
 // Kommunikation in verteilten Systemen - Simulation Model 1
 // This code was adapted from ns3's bulk-send-application code
 // The original code is not able to use udp sockets because udp sockets cannot
-// emit the "connection established" event.
-// We try to schedule the first sent packet at simulator time 0 instead, if we shall use an udp socket.
-// This is mostly untested!
-
-#include <math.h>
+// emit the "connection established" event. The sending is therefore split into a
+// TCP engine (TcpBulkSendApplication) and a UDP engine (UdpBulkSendApplication),
+// this class only holds what both of them share.
+// When the TraceFile attribute is set, packet sizes and inter-arrival times are replayed from a trace file instead.
+// The file is read record by record while the simulation runs.
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <ctype.h>
 #include "ns3/log.h"
 #include "ns3/address.h"
 #include "ns3/node.h"
@@ -35,9 +39,11 @@
 #include "ns3/socket-factory.h"
 #include "ns3/packet.h"
 #include "ns3/uinteger.h"
+#include "ns3/string.h"
 #include "ns3/trace-source-accessor.h"
 #include "ns3/tcp-socket-factory.h"
-#include "ns3/udp-socket.h"
+#include "ns3/inet-socket-address.h"
+#include "ns3/inet6-socket-address.h"
 #include "custom-bulk-send-application.h"
 
 namespace ns3 {
@@ -51,7 +57,6 @@ namespace ns3 {
         static TypeId tid = TypeId("ns3::CustomBulkSendApplication")
                 .SetParent<Application>()
                 .SetGroupName("Applications")
-                .AddConstructor<CustomBulkSendApplication>()
                 .AddAttribute("SendSize", "The amount of data to send each time.",
                               UintegerValue(512),
                               MakeUintegerAccessor(&CustomBulkSendApplication::m_sendSize),
@@ -68,16 +73,12 @@ namespace ns3 {
                               UintegerValue(0),
                               MakeUintegerAccessor(&CustomBulkSendApplication::m_maxBytes),
                               MakeUintegerChecker<uint64_t>())
-                .AddAttribute("UdpInterval",
-                              "UDP connections: Resend packets every x ms",
-                              UintegerValue(100),
-                              MakeUintegerAccessor(&CustomBulkSendApplication::m_udpinterval),
-                              MakeUintegerChecker<uint32_t>())
-                .AddAttribute("UdpCount",
-                              "UDP connections: Send x packets every timeframe",
-                              UintegerValue(100),
-                              MakeUintegerAccessor(&CustomBulkSendApplication::m_udpcount),
-                              MakeUintegerChecker<uint32_t>())
+                .AddAttribute("TraceFile",
+                              "Replay packet sizes and inter-arrival times from this file instead of "
+                              "sending as fast as possible. Empty for bulk transfer.",
+                              StringValue(""),
+                              MakeStringAccessor(&CustomBulkSendApplication::m_traceFile),
+                              MakeStringChecker())
                 .AddAttribute("Protocol", "The type of protocol to use.",
                               TypeIdValue(TcpSocketFactory::GetTypeId()),
                               MakeTypeIdAccessor(&CustomBulkSendApplication::m_tid),
@@ -91,10 +92,10 @@ namespace ns3 {
 
     CustomBulkSendApplication::CustomBulkSendApplication()
             : m_socket(0),
-              m_connected(false),
-              m_isudp(false),
               m_totBytes(0),
-              m_rxBytes(0) {
+              m_sendFailures(0),
+              m_traceSize(0),
+              m_traceDone(false) {
         NS_LOG_FUNCTION (this);
     }
 
@@ -114,6 +115,10 @@ namespace ns3 {
         return m_socket;
     }
 
+    void
+    CustomBulkSendApplication::AnnouncePacketsReceived(uint64_t rxcnt) {
+    }
+
     void
     CustomBulkSendApplication::DoDispose(void) {
         NS_LOG_FUNCTION (this);
@@ -123,133 +128,108 @@ namespace ns3 {
         Application::DoDispose();
     }
 
-// Application Methods
-    void CustomBulkSendApplication::StartApplication(void) // Called at time specified by Start
+    void CustomBulkSendApplication::StopApplication(void) // Called at time specified by Stop
     {
         NS_LOG_FUNCTION (this);
 
-        // Create the socket if not already
-        if (!m_socket) {
-            m_socket = Socket::CreateSocket(GetNode(), m_tid);
-
-            if (m_socket->GetSocketType() != Socket::NS3_SOCK_STREAM &&
-                m_socket->GetSocketType() != Socket::NS3_SOCK_SEQPACKET) {
-                // This seems to be an UDP socket, which has no idea of "connections".
-                // We need to schedule this by ourselves!
-                NS_LOG_INFO("This seems to be an UDP socket, which is not supported in ns3's regular implementation. "
-                            "CustomBulkSendApplication was patched to allow this and seems to work, but please take the "
-                            "measurements with a grain of salt!");
-                m_connected = true;
-                m_isudp = true;
-                Simulator::Schedule(Seconds(0), &CustomBulkSendApplication::SendData, this);
-            }
-
-            if (Inet6SocketAddress::IsMatchingType(m_peer)) {
-                if (m_socket->Bind6() == -1) {
-                    NS_FATAL_ERROR ("Failed to bind socket");
-                }
-            } else if (InetSocketAddress::IsMatchingType(m_peer)) {
-                if (m_socket->Bind() == -1) {
-                    NS_FATAL_ERROR ("Failed to bind socket");
-                }
-            }
-
-            m_socket->Connect(m_peer);
-            m_socket->ShutdownRecv();
-            m_socket->SetConnectCallback(
-                    MakeCallback(&CustomBulkSendApplication::ConnectionSucceeded, this),
-                    MakeCallback(&CustomBulkSendApplication::ConnectionFailed, this));
-            m_socket->SetSendCallback(
-                    MakeCallback(&CustomBulkSendApplication::DataSend, this));
+        m_replayEvent.Cancel();
+        if (m_trace.is_open()) {
+            m_trace.close();
         }
-        if (m_connected) {
-            SendData();
-        }
-    }
-
-    void CustomBulkSendApplication::StopApplication(void) // Called at time specified by Stop
-    {
-        NS_LOG_FUNCTION (this);
 
         if (m_socket != 0) {
             m_socket->Close();
-            m_connected = false;
-        } else {
-            NS_LOG_WARN ("CustomBulkSendApplication found null socket to close in StopApplication");
         }
     }
 
 
-// Private helpers
+// Helpers for the engines
 
-    void CustomBulkSendApplication::SendData(void) {
+    Ptr<Socket> CustomBulkSendApplication::CreateConnectedSocket(void) {
         NS_LOG_FUNCTION (this);
-        uint32_t usendcount = 0;
-        while (m_maxBytes == 0 || (!m_isudp && (m_totBytes < m_maxBytes)) ||
-               (m_isudp && (usendcount < m_udpcount))) { // Time to send more
-
-            // uint64_t to allow the comparison later.
-            // the result is in a uint32_t range anyway, because
-            // m_sendSize is uint32_t.
-            uint64_t toSend = m_sendSize;
-            // Make sure we don't send too many
-            if (m_maxBytes > 0 && !m_isudp) {
-                toSend = std::min(toSend, m_maxBytes - m_totBytes);
-            }
 
-            NS_LOG_LOGIC ("sending packet at " << Simulator::Now());
-            Ptr<Packet> packet = Create<Packet>(toSend);
-            int actual = m_socket->Send(packet);
-            if (actual > 0) {
-                m_totBytes += actual;
-                usendcount++;
-                m_txTrace(packet);
+        Ptr<Socket> socket = Socket::CreateSocket(GetNode(), m_tid);
+        if (Inet6SocketAddress::IsMatchingType(m_peer)) {
+            if (socket->Bind6() == -1) {
+                NS_FATAL_ERROR ("Failed to bind socket");
             }
-            // We exit this loop when actual < toSend as the send side
-            // buffer is full. The "DataSent"this->m_sendSize callback will pop when
-            // some buffer space has freed ip.
-            if ((unsigned) actual != toSend) {
-                break;
+        } else if (InetSocketAddress::IsMatchingType(m_peer)) {
+            if (socket->Bind() == -1) {
+                NS_FATAL_ERROR ("Failed to bind socket");
             }
         }
-        // Check if time to close (all sent)
-        if (!m_isudp && (m_totBytes >= m_maxBytes)) {
-            m_socket->Close();
-            m_connected = false;
-            NS_LOG_INFO("All packets sent at " << Simulator::Now());
+
+        socket->Connect(m_peer);
+        socket->ShutdownRecv();
+        return socket;
+    }
+
+    void CustomBulkSendApplication::StartReplay(void) {
+        NS_LOG_FUNCTION (this);
+
+        if (m_trace.is_open() || m_traceDone) {
+            // Replay has already been started
+            return;
         }
-        if (m_isudp && (m_rxBytes >= m_maxBytes)) {
-            m_socket->Close();
-            m_connected = false;
-            NS_LOG_INFO("All packets sent at " << Simulator::Now());
-        } else if (m_isudp && m_rxBytes < m_maxBytes) {
-            Simulator::Schedule(MilliSeconds(m_udpinterval), &CustomBulkSendApplication::SendData, this);
+        m_trace.open(m_traceFile.c_str());
+        if (!m_trace.is_open()) {
+            NS_FATAL_ERROR ("Unable to open trace file " << m_traceFile);
+        }
+        if (ReadTraceRecord()) {
+            ScheduleReplay();
         }
     }
 
-    void CustomBulkSendApplication::ConnectionSucceeded(Ptr<Socket> socket) {
-        NS_LOG_FUNCTION (this << socket);
-        NS_LOG_LOGIC ("CustomBulkSendApplication Connection succeeded");
-        m_connected = true;
-        SendData();
-    }
+    bool CustomBulkSendApplication::ReadTraceRecord(void) {
+        while (std::getline(m_trace, m_traceLine)) {
+            const char *line = m_traceLine.c_str();
+            while (isspace(*line)) {
+                line++;
+            }
+            if (*line == '\0' || *line == '#') {
+                continue;
+            }
 
-    void CustomBulkSendApplication::ConnectionFailed(Ptr<Socket> socket) {
-        NS_LOG_FUNCTION (this << socket);
-        NS_LOG_LOGIC ("CustomBulkSendApplication, Connection Failed");
+            char *gapEnd;
+            char *sizeEnd;
+            double gap = strtod(line, &gapEnd);
+            const char *sizeStart = gapEnd;
+            while (isspace(*sizeStart)) {
+                sizeStart++;
+            }
+            // strtoull accepts (and negates) a sign, which would turn "-1" into a huge size
+            unsigned long long size = strtoull(sizeStart, &sizeEnd, 10);
+            if (gapEnd == line || sizeEnd == sizeStart || !isdigit(*sizeStart) || gap < 0) {
+                NS_FATAL_ERROR ("Malformed line in trace file " << m_traceFile << ": " << m_traceLine);
+            }
+            if (size > GetMaxRecordSize()) {
+                NS_FATAL_ERROR ("Packet of " << sizeStart << " bytes in trace file " << m_traceFile
+                                << " exceeds the maximum of " << GetMaxRecordSize() << " bytes");
+            }
+            m_traceGap = Seconds(gap);
+            m_traceSize = size;
+            return true;
+        }
+        m_traceDone = true;
+        m_trace.close();
+        return false;
     }
 
-    void CustomBulkSendApplication::DataSend(Ptr<Socket>, uint32_t) {
-        NS_LOG_FUNCTION (this);
+    uint32_t CustomBulkSendApplication::GetMaxRecordSize(void) const {
+        return UINT32_MAX;
+    }
 
-        if (m_connected) { // Only send new data if the connection has completed
-            SendData();
-        }
+    void CustomBulkSendApplication::SendFailed(uint32_t size) {
+        m_sendFailures++;
+        NS_LOG_WARN ("Socket refused to send " << size << " bytes at " << Simulator::Now());
     }
 
-    void CustomBulkSendApplication::AnnouncePacketsReceived(uint64_t rxcnt) {
-        m_rxBytes = rxcnt;
+    uint64_t CustomBulkSendApplication::GetSendFailures(void) const {
+        return m_sendFailures;
     }
 
+    void CustomBulkSendApplication::ScheduleReplay(void) {
+        m_replayEvent = Simulator::Schedule(m_traceGap, &CustomBulkSendApplication::ReplayTraceRecord, this);
+    }
 
 } // Namespace ns3
@@ -21,9 +21,12 @@
 #ifndef CUSTOM_BULK_SEND_APPLICATION_H
 #define CUSTOM_BULK_SEND_APPLICATION_H
 
+#include <fstream>
+#include <string>
 #include "ns3/address.h"
 #include "ns3/application.h"
 #include "ns3/event-id.h"
+#include "ns3/nstime.h"
 #include "ns3/ptr.h"
 #include "ns3/traced-callback.h"
 
@@ -40,31 +43,31 @@ namespace ns3 {
  * This traffic generator simply sends data
  * as fast as possible up to MaxBytes or until
  * the application is stopped (if MaxBytes is
- * zero). Once the lower layer send buffer is
- * filled, it waits until space is free to
- * send more data, essentially keeping a
- * constant flow of data. Only SOCK_STREAM
- * and SOCK_SEQPACKET sockets are supported.
- * For example, TCP sockets can be used, but
- * UDP sockets can not be used.
+ * zero).
+ *
+ * The sending itself is protocol specific and implemented by two engines:
+ * TcpBulkSendApplication fills the send buffer of a connected stream socket
+ * whenever space becomes free, UdpBulkSendApplication sends a burst of
+ * datagrams every interval until the receiver announces that MaxBytes have
+ * arrived. CustomBulkSendHelper picks the engine from the Protocol.
+ *
+ * If a TraceFile is given, the application does not send as fast as possible
+ * but replays the trace instead. Every line of the trace contains the time
+ * since the previous packet (in seconds) and the size of the packet (in bytes),
+ * separated by whitespace. Lines starting with '#' are ignored. This is the
+ * format `tshark -T fields -e frame.time_delta -e udp.length` produces.
+ * The trace is read line by line while the simulation runs, so traces of
+ * arbitrary length can be replayed using a constant amount of memory.
  */
 
 /**
  * \ingroup bulksend
  *
- * \brief Send as much traffic as possible, trying to fill the bandwidth.
- *
- * This traffic generator simply sends data
- * as fast as possible up to MaxBytes or until
- * the application is stopped (if MaxBytes is
- * zero). Once the lower layer send buffer is
- * filled, it waits until space is free to
- * send more data, essentially keeping a
- * constant flow of data. Only SOCK_STREAM
- * and SOCK_SEQPACKET sockets are supported.
- * For example, TCP sockets can be used, but
- * UDP sockets can not be used.
+ * \brief Common part of the TCP and UDP bulk senders.
  *
+ * Holds the attributes both engines share, creates and connects sockets and
+ * reads the trace to replay. The engines implement StartApplication and the
+ * replay of a single trace record.
  */
     class CustomBulkSendApplication : public Application {
     public:
@@ -99,53 +102,90 @@ namespace ns3 {
          */
         Ptr<Socket> GetSocket(void) const;
 
-        void AnnouncePacketsReceived(uint64_t rxcnt);
+        /**
+         * \brief Tell the sender how many bytes the receiver got so far.
+         *
+         * A datagram sender does not learn from its socket when all data has
+         * arrived, so it keeps sending until this reaches MaxBytes. Stream
+         * senders ignore it.
+         *
+         * \param rxcnt the number of bytes received
+         */
+        virtual void AnnouncePacketsReceived(uint64_t rxcnt);
+
+        /**
+         * \brief Get the number of packets the socket refused to send.
+         * \return the number of failed sends
+         */
+        uint64_t GetSendFailures(void) const;
 
     protected:
         virtual void DoDispose(void);
 
-    private:
         // inherited from Application base class.
-        virtual void StartApplication(void);    // Called at time specified by Start
         virtual void StopApplication(void);     // Called at time specified by Stop
 
         /**
-         * \brief Send data until the L4 transmission buffer is full.
+         * \brief Create a socket of the Protocol, bind it and connect it to the Remote.
+         * \return the socket
          */
-        void SendData();
+        Ptr<Socket> CreateConnectedSocket(void);
 
-        Ptr<Socket> m_socket;       //!< Associated socket
-        Address m_peer;         //!< Peer address
-        bool m_connected;    //!< True if connected
-        uint32_t m_sendSize;     //!< Size of data to send each time
-        uint64_t m_maxBytes;     //!< Limit total number of bytes sent
-        uint64_t m_totBytes;     //!< Total bytes sent so far
-        TypeId m_tid;          //!< The type of protocol to use.
-        uint64_t m_rxBytes;
-        bool m_isudp;
-        uint32_t m_udpinterval;
-        uint32_t m_udpcount;
+        /**
+         * \brief Open the trace file and schedule the replay of its first record.
+         *
+         * Does nothing if the replay has already been started.
+         */
+        void StartReplay(void);
 
-        /// Traced Callback: sent packets
-        TracedCallback<Ptr<const Packet> > m_txTrace;
+        /**
+         * \brief Read the next packet from the trace file.
+         *
+         * Records larger than GetMaxRecordSize are fatal.
+         *
+         * \return false if the end of the trace has been reached
+         */
+        bool ReadTraceRecord(void);
 
-    private:
         /**
-         * \brief Connection Succeeded (called by Socket through a callback)
-         * \param socket the connected socket
+         * \return the largest packet of a trace the engine can send
          */
-        void ConnectionSucceeded(Ptr<Socket> socket);
+        virtual uint32_t GetMaxRecordSize(void) const;
 
         /**
-         * \brief Connection Failed (called by Socket through a callback)
-         * \param socket the connected socket
+         * \brief Account a packet the socket refused to send.
+         * \param size the size of the packet
          */
-        void ConnectionFailed(Ptr<Socket> socket);
+        void SendFailed(uint32_t size);
 
         /**
-         * \brief Send more data as soon as some has been transmitted.
+         * \brief Schedule the replay of the record read last.
          */
-        void DataSend(Ptr<Socket>, uint32_t); // for socket's SetSendCallback
+        void ScheduleReplay(void);
+
+        /**
+         * \brief Send the packet read from the trace and schedule the next one.
+         */
+        virtual void ReplayTraceRecord(void) = 0;
+
+        Ptr<Socket> m_socket;   //!< Associated socket
+        Address m_peer;         //!< Peer address
+        uint32_t m_sendSize;    //!< Size of data to send each time
+        uint64_t m_maxBytes;    //!< Limit total number of bytes sent
+        uint64_t m_totBytes;    //!< Total bytes sent so far
+        uint64_t m_sendFailures;    //!< Packets the socket refused to send
+        TypeId m_tid;           //!< The type of protocol to use.
+
+        std::string m_traceFile;    //!< Trace to replay, empty for bulk transfer
+        std::ifstream m_trace;      //!< The opened trace file
+        std::string m_traceLine;    //!< Line buffer for reading the trace
+        Time m_traceGap;            //!< Time between the previous and the next packet of the trace
+        uint32_t m_traceSize;       //!< Size of the next packet of the trace
+        bool m_traceDone;           //!< True if the whole trace has been read
+        EventId m_replayEvent;      //!< Event to send the next packet of the trace
+
+        /// Traced Callback: sent packets
+        TracedCallback<Ptr<const Packet> > m_txTrace;
     };
 
 } // namespace ns3
@@ -25,11 +25,17 @@
 #include "ns3/packet-socket-address.h"
 #include "ns3/string.h"
 #include "ns3/names.h"
+#include "ns3/udp-socket-factory.h"
 
 namespace ns3 {
 
     CustomBulkSendHelper::CustomBulkSendHelper(std::string protocol, Address address) {
-        m_factory.SetTypeId("ns3::CustomBulkSendApplication");
+        // Datagrams need an engine of their own, everything else is sent as a stream
+        if (TypeId::LookupByName(protocol) == UdpSocketFactory::GetTypeId()) {
+            m_factory.SetTypeId("ns3::UdpBulkSendApplication");
+        } else {
+            m_factory.SetTypeId("ns3::TcpBulkSendApplication");
+        }
         m_factory.Set("Protocol", StringValue(protocol));
         m_factory.Set("Remote", AddressValue(address));
     }
@@ -38,6 +38,11 @@ namespace ns3 {
  * \ingroup bulksend
  * \brief A helper to make it easier to instantiate an ns3::CustomBulkSendApplication
  * on a set of nodes.
+ *
+ * The protocol selects the engine: ns3::UdpSocketFactory installs an
+ * ns3::UdpBulkSendApplication, any other protocol an ns3::TcpBulkSendApplication.
+ * Attributes only one of them has (e.g. UdpInterval, Connections) must only
+ * be set for that protocol.
  */
     class CustomBulkSendHelper {
     public:
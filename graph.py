@@ -101,6 +101,668 @@ def udp_packet_loss(tcp_comparison=False, routing=False):
     with open('udp_loss.json' if not tcp_comparison else 'udp_comparison.json', 'w') as fp:
         json.dump(test_results, fp)
 
+def routing_comparison(socket_factory='ns3::TcpSocketFactory'):
+    protocols = ('static', 'ns3', 'olsr', 'aodv', 'dsdv', 'dsr')
+    distances = (3, 6, 12, 25, 75, 100, 150, 200, 400, 600)
+    size = 1000000
+    start_time = 10260
+
+    test_results = []
+
+    for protocol in protocols:
+        for distance in distances:
+            run_app = ['./simulation3', '--height=100', f'--maxBytes={size}', f'--distance={distance}',
+                       f'--routing={protocol}', f'--socket_factory={socket_factory}']
+            result = simulate(run_app)
+            throughput = 0
+            discovery = None
+            if not result['rx_bytes_application'] == 0:
+                time_taken = (result['rx_ms_last'] - start_time) / 1000
+                throughput = (result['rx_bytes_application'] / 1000) / time_taken
+                discovery = result['rx_ms_first'] - start_time
+            test_results.append({
+                'protocol': protocol,
+                'distance': distance,
+                'throughput': throughput,
+                'control_bytes': result['routing']['control_bytes'],
+                'control_packets': result['routing']['control_packets'],
+                'first_rx_delay': discovery,
+                'command_line': run_app,
+                'raw_data': result
+            })
+    with open('routing_comparison.json', 'w') as fp:
+        json.dump(test_results, fp)
+
+    print(f"{'protocol':>8} {'distance':>8} {'kB/s':>10} {'ctrl bytes':>12} {'first rx (ms)':>14}")
+    for r in test_results:
+        print(f"{r['protocol']:>8} {r['distance']:>8} {r['throughput']:>10.1f} {r['control_bytes']:>12} {str(r['first_rx_delay']):>14}")
+
+def routing_comparison_graph():
+    with open('routing_comparison.json', 'r') as fp:
+        data = json.load(fp)
+    protocols = ('static', 'ns3', 'olsr', 'aodv', 'dsdv', 'dsr')
+    distances = (3, 6, 12, 25, 75, 100, 150, 200, 400, 600)
+    metrics = (('throughput', 'Throughput (kB/s)'),
+               ('control_bytes', 'Routing control (bytes)'),
+               ('first_rx_delay', 'Delay of first packet (ms)'))
+
+    fig, axs = plt.subplots(len(metrics), 1, sharex=True)
+    for idx, (metric, label) in enumerate(metrics):
+        for protocol in protocols:
+            values = [None for d in distances]
+            for datapoint in data:
+                if datapoint['protocol'] == protocol:
+                    values[map_on_index(datapoint['distance'], distances)] = datapoint[metric]
+            axs[idx].plot(distances, values, '-o', label=protocol)
+        axs[idx].set_xlabel("Distance (m)")
+        axs[idx].set_ylabel(label)
+        axs[idx].legend()
+    axs[0].set_title("Routing protocol comparison (h=100m, s=1MB)")
+    fig.tight_layout()
+    plt.show()
+
+def aggregation_comparison():
+    configurations = (
+        ('802.11g', ['--standard=g']),
+        ('802.11n', ['--standard=n-5', '--max_ampdu=0']),
+        ('802.11n A-MPDU', ['--standard=n-5']),
+        ('802.11n A-MPDU+A-MSDU', ['--standard=n-5', '--max_amsdu=7935']),
+        ('802.11ac A-MPDU', ['--standard=ac']),
+    )
+    hops = (1, 2, 3, 5, 7)
+    size = 1000000
+    start_time = 10260
+
+    test_results = []
+
+    for name, options in configurations:
+        for hop in hops:
+            run_app = ['./simulation3', '--height=100', f'--maxBytes={size}', '--distance=25',
+                       f'--nodes={hop + 1}'] + options
+            result = simulate(run_app)
+            throughput = 0
+            if not result['rx_bytes_application'] == 0:
+                time_taken = (result['rx_ms_last'] - start_time) / 1000
+                throughput = (result['rx_bytes_application'] / 1000) / time_taken
+            test_results.append({
+                'configuration': name,
+                'hops': hop,
+                'throughput': throughput,
+                'command_line': run_app,
+                'raw_data': result
+            })
+    with open('aggregation_comparison.json', 'w') as fp:
+        json.dump(test_results, fp)
+
+    # Share of the single hop throughput that is left after n hops
+    print(f"{'configuration':>24} {'hops':>5} {'kB/s':>10} {'of 1 hop':>9}")
+    for r in test_results:
+        single = [s['throughput'] for s in test_results if s['configuration'] == r['configuration'] and s['hops'] == 1][0]
+        share = r['throughput'] / single if single else 0
+        print(f"{r['configuration']:>24} {r['hops']:>5} {r['throughput']:>10.1f} {share:>9.2f}")
+
+def aggregation_comparison_graph():
+    with open('aggregation_comparison.json', 'r') as fp:
+        data = json.load(fp)
+    hops = (1, 2, 3, 5, 7)
+    configurations = []
+    for datapoint in data:
+        if datapoint['configuration'] not in configurations:
+            configurations.append(datapoint['configuration'])
+
+    for configuration in configurations:
+        values = [None for h in hops]
+        for datapoint in data:
+            if datapoint['configuration'] == configuration:
+                values[map_on_index(datapoint['hops'], hops)] = datapoint['throughput']
+        plt.plot(hops, values, '-o', label=configuration)
+    plt.xlabel("Hops")
+    plt.ylabel("Throughput (kB/s)")
+    plt.title("Multi-hop throughput with frame aggregation (h=100m, d=25m, s=1MB)")
+    plt.legend()
+    plt.show()
+
+def multichannel_comparison(routing='static'):
+    topologies = ('single', 'multichannel')
+    hops = (1, 2, 3, 5, 7)
+    size = 1000000
+    start_time = 10260
+
+    test_results = []
+
+    for topology in topologies:
+        for hop in hops:
+            run_app = ['./simulation3', '--height=100', f'--maxBytes={size}', '--distance=25',
+                       f'--nodes={hop + 1}', f'--topology={topology}', f'--routing={routing}']
+            result = simulate(run_app)
+            throughput = 0
+            if not result['rx_bytes_application'] == 0:
+                time_taken = (result['rx_ms_last'] - start_time) / 1000
+                throughput = (result['rx_bytes_application'] / 1000) / time_taken
+            test_results.append({
+                'topology': topology,
+                'hops': hop,
+                'throughput': throughput,
+                'command_line': run_app,
+                'raw_data': result
+            })
+    with open('multichannel_comparison.json', 'w') as fp:
+        json.dump(test_results, fp)
+
+    print(f"{'hops':>5} {'single (kB/s)':>14} {'multi (kB/s)':>14} {'gain':>6}")
+    for hop in hops:
+        single = [r['throughput'] for r in test_results if r['topology'] == 'single' and r['hops'] == hop][0]
+        multi = [r['throughput'] for r in test_results if r['topology'] == 'multichannel' and r['hops'] == hop][0]
+        gain = multi / single if single else 0
+        print(f"{hop:>5} {single:>14.1f} {multi:>14.1f} {gain:>6.2f}")
+
+def multichannel_comparison_graph():
+    with open('multichannel_comparison.json', 'r') as fp:
+        data = json.load(fp)
+    hops = (1, 2, 3, 5, 7)
+    for topology, label in (('single', 'One shared channel'), ('multichannel', 'Alternating channels')):
+        values = [None for h in hops]
+        for datapoint in data:
+            if datapoint['topology'] == topology:
+                values[map_on_index(datapoint['hops'], hops)] = datapoint['throughput']
+        plt.plot(hops, values, '-o', label=label)
+    plt.xlabel("Hops")
+    plt.ylabel("Throughput (kB/s)")
+    plt.title("Single vs. multi channel relay chain (h=100m, d=25m, s=1MB)")
+    plt.legend()
+    plt.show()
+
+def backhaul_comparison(routing='static'):
+    rates = (1, 2, 5, 10, 20, 50, 100)
+    size = 1000000
+    start_time = 10260
+
+    test_results = []
+
+    for rate in rates:
+        run_app = ['./simulation3', '--height=100', f'--maxBytes={size}', '--distance=25', '--nodes=6',
+                   '--topology=hybrid', '--segments=2', f'--backhaul_rate={rate}Mbps', f'--routing={routing}',
+                   '--airtime']
+        result = simulate(run_app)
+        throughput = 0
+        if not result['rx_bytes_application'] == 0:
+            time_taken = (result['rx_ms_last'] - start_time) / 1000
+            throughput = (result['rx_bytes_application'] / 1000) / time_taken
+        test_results.append({
+            'rate': rate,
+            'throughput': throughput,
+            'backhaul_utilisation': max(link['utilisation'] for link in result['backhaul']),
+            'air_utilisation': result['airtime']['max_node_utilisation'],
+            'command_line': run_app,
+            'raw_data': result
+        })
+    with open('backhaul_comparison.json', 'w') as fp:
+        json.dump(test_results, fp)
+
+    # The link which is busy (close to 1) all the time is the bottleneck
+    print(f"{'Mbps':>5} {'kB/s':>10} {'backhaul util':>14} {'air util':>9}")
+    for r in test_results:
+        print(f"{r['rate']:>5} {r['throughput']:>10.1f} {r['backhaul_utilisation']:>14.2f} {r['air_utilisation']:>9.2f}")
+
+def backhaul_comparison_graph():
+    with open('backhaul_comparison.json', 'r') as fp:
+        data = json.load(fp)
+    rates = [datapoint['rate'] for datapoint in data]
+
+    fig, axs = plt.subplots(2, 1, sharex=True)
+    axs[0].plot(rates, [datapoint['throughput'] for datapoint in data], '-o')
+    axs[0].set_ylabel("Throughput (kB/s)")
+    axs[0].set_title("Wifi segments with p2p backhaul (2 segments of 3 routers, s=1MB)")
+    axs[1].plot(rates, [datapoint['backhaul_utilisation'] for datapoint in data], '-o', label='Backhaul')
+    axs[1].plot(rates, [datapoint['air_utilisation'] for datapoint in data], '-o', label='Air (busiest router)')
+    axs[1].set_xscale('log')
+    axs[1].set_xlabel("Backhaul data rate (Mbps)")
+    axs[1].set_ylabel("Utilisation")
+    axs[1].legend()
+    fig.tight_layout()
+    plt.show()
+
+def rts_cts_comparison(socket_factory='ns3::TcpSocketFactory'):
+    thresholds = (('off', 65535), ('all', 0), ('>500B', 500))
+    # At 1.5m neighbours decode each other up to about 0.6 of the carrier sense range (802.11g, default power)
+    ratios = (0.4, 0.53, 0.57)
+    size = 1000000
+    start_time = 10260
+
+    test_results = []
+
+    for name, threshold in thresholds:
+        for ratio in ratios:
+            run_app = ['./simulation3', '--height=1.5', f'--maxBytes={size}', f'--hidden={ratio}',
+                       f'--rts_cts_threshold={threshold}', f'--socket_factory={socket_factory}', '--collisions']
+            result = simulate(run_app)
+            throughput = 0
+            if not result['rx_bytes_application'] == 0:
+                time_taken = (result['rx_ms_last'] - start_time) / 1000
+                throughput = (result['rx_bytes_application'] / 1000) / time_taken
+            test_results.append({
+                'rts_cts': name,
+                'ratio': ratio,
+                'throughput': throughput,
+                'rx_error': result['collisions']['rx_error'],
+                'retransmissions': result['collisions']['retransmissions'],
+                'command_line': run_app,
+                'raw_data': result
+            })
+    with open('rts_cts_comparison.json', 'w') as fp:
+        json.dump(test_results, fp)
+
+    # Ratios above 0.5 hide the neighbours of every relay from each other
+    print(f"{'RTS/CTS':>8} {'ratio':>6} {'kB/s':>10} {'gain':>6} {'rx errors':>10} {'retrans':>8}")
+    for r in test_results:
+        off = [o['throughput'] for o in test_results if o['rts_cts'] == 'off' and o['ratio'] == r['ratio']][0]
+        gain = r['throughput'] / off if off else 0
+        print(f"{r['rts_cts']:>8} {r['ratio']:>6} {r['throughput']:>10.1f} {gain:>6.2f} {r['rx_error']:>10} {r['retransmissions']:>8}")
+
+def aqm_comparison(simulation='simulation1'):
+    queue_discs = ('pfifo_fast', 'codel', 'fq_codel', 'pie')
+    limits = ('', '100p', '1000p')
+    size = 20000000 if simulation == 'simulation1' else 1000000
+
+    test_results = []
+
+    for queue_disc in queue_discs:
+        for limit in limits:
+            run_app = [f'./{simulation}', f'--maxBytes={size}', f'--queue_disc={queue_disc}',
+                       '--device_queue=1p', '--probe_interval=100']
+            if limit:
+                run_app.append(f'--queue_limit={limit}')
+            result = simulate(run_app)
+            test_results.append({
+                'queue_disc': queue_disc,
+                'limit': limit if limit else 'default',
+                'goodput': result['goodput_bps'] / 1e6,
+                'queueing_delay': result['probe']['queueing_delay_avg_ms'],
+                'rtt_p95': result['probe']['rtt_p95_ms'],
+                'drops': sum(disc['drops'] for disc in result['queue_discs']),
+                'command_line': run_app,
+                'raw_data': result
+            })
+    with open(f'aqm_comparison_{simulation}.json', 'w') as fp:
+        json.dump(test_results, fp)
+
+    print(f"{'queue disc':>10} {'limit':>8} {'Mbps':>8} {'delay (ms)':>11} {'p95 RTT':>8} {'drops':>7}")
+    for r in test_results:
+        print(f"{r['queue_disc']:>10} {r['limit']:>8} {r['goodput']:>8.2f} {r['queueing_delay']:>11.2f} {r['rtt_p95']:>8.2f} {r['drops']:>7}")
+
+def tcp_variant_comparison(routing='olsr'):
+    variants = ('newreno', 'westwoodplus', 'vegas', 'bic', 'hybla', 'highspeed')
+    distances = (3, 12, 25, 75, 100, 150, 200)
+    size = 1000000
+    start_time = 10260
+
+    test_results = []
+
+    for variant in variants:
+        for distance in distances:
+            run_app = ['./simulation3', '--height=100', f'--maxBytes={size}', f'--distance={distance}',
+                       f'--tcp_variant={variant}', '--segment_size=1448', f'--routing={routing}']
+            result = simulate(run_app)
+            throughput = 0
+            if not result['rx_bytes_application'] == 0:
+                time_taken = (result['rx_ms_last'] - start_time) / 1000
+                throughput = (result['rx_bytes_application'] / 1000) / time_taken
+            test_results.append({
+                'variant': variant,
+                'distance': distance,
+                'throughput': throughput,
+                'command_line': run_app,
+                'raw_data': result
+            })
+    with open('tcp_variant_comparison.json', 'w') as fp:
+        json.dump(test_results, fp)
+
+    # One row per distance, one column per variant (kB/s)
+    print(f"{'distance':>8} " + ' '.join(f'{variant:>12}' for variant in variants))
+    for distance in distances:
+        row = [r['throughput'] for v in variants for r in test_results if r['variant'] == v and r['distance'] == distance]
+        print(f'{distance:>8} ' + ' '.join(f'{value:>12.1f}' for value in row))
+
+def tcp_variant_comparison_graph():
+    with open('tcp_variant_comparison.json', 'r') as fp:
+        data = json.load(fp)
+    variants = []
+    for datapoint in data:
+        if datapoint['variant'] not in variants:
+            variants.append(datapoint['variant'])
+    for variant in variants:
+        points = [datapoint for datapoint in data if datapoint['variant'] == variant]
+        plt.plot([p['distance'] for p in points], [p['throughput'] for p in points], '-o', label=variant)
+    plt.xlabel("Distance (m)")
+    plt.ylabel("Throughput (kB/s)")
+    plt.title("TCP congestion control over the multi-hop wifi path (h=100m, s=1MB)")
+    plt.legend()
+    plt.show()
+
+def parallel_comparison(routing='olsr'):
+    connections = (1, 2, 4, 8)
+    distances = (3, 12, 25, 75, 100, 150, 200)
+    size = 1000000
+
+    test_results = []
+
+    for count in connections:
+        for distance in distances:
+            run_app = ['./simulation3', '--height=100', f'--maxBytes={size}', f'--distance={distance}',
+                       f'--connections={count}', f'--routing={routing}']
+            result = simulate(run_app)
+            stats = result['connections']
+            test_results.append({
+                'connections': count,
+                'distance': distance,
+                'throughput': stats['throughput_bps'] / 8000,
+                'completion_ms': stats['completion_ms'],
+                'fairness': stats['fairness'],
+                'command_line': run_app,
+                'raw_data': result
+            })
+    with open('parallel_comparison.json', 'w') as fp:
+        json.dump(test_results, fp)
+
+    # Gain: aggregate throughput of the parallel connections relative to a single connection
+    print(f"{'distance':>8} {'conns':>6} {'kB/s':>10} {'gain':>6} {'done (ms)':>10} {'fairness':>9}")
+    for r in test_results:
+        single = [s['throughput'] for s in test_results if s['connections'] == 1 and s['distance'] == r['distance']][0]
+        gain = r['throughput'] / single if single else 0
+        print(f"{r['distance']:>8} {r['connections']:>6} {r['throughput']:>10.1f} {gain:>6.2f} {r['completion_ms']:>10} {r['fairness']:>9.2f}")
+
+def parallel_comparison_graph():
+    with open('parallel_comparison.json', 'r') as fp:
+        data = json.load(fp)
+    connections = sorted(set(datapoint['connections'] for datapoint in data))
+    for count in connections:
+        points = [datapoint for datapoint in data if datapoint['connections'] == count]
+        plt.plot([p['distance'] for p in points], [p['throughput'] for p in points], '-o',
+                 label=f'{count} connection' + ('s' if count > 1 else ''))
+    plt.xlabel("Distance (m)")
+    plt.ylabel("Aggregate throughput (kB/s)")
+    plt.title("Striped transfer over parallel TCP connections (h=100m, s=1MB)")
+    plt.legend()
+    plt.show()
+
+def request_response_comparison(routing='olsr'):
+    concurrencies = (1, 2, 4, 8, 16)
+    distances = (25, 75, 150)
+
+    test_results = []
+
+    for distance in distances:
+        for concurrency in concurrencies:
+            run_app = ['./simulation3', '--height=100', f'--distance={distance}', '--workload=request_response',
+                       f'--concurrency={concurrency}', '--transactions=2000', f'--routing={routing}']
+            result = simulate(run_app)
+            stats = result['request_response']
+            test_results.append({
+                'distance': distance,
+                'concurrency': concurrency,
+                'tps': stats['tps'],
+                'p50': stats['latency_p50_ms'],
+                'p99': stats['latency_p99_ms'],
+                'command_line': run_app,
+                'raw_data': result
+            })
+    with open('request_response_comparison.json', 'w') as fp:
+        json.dump(test_results, fp)
+
+    # More outstanding transactions raise the TPS until the path saturates, then only the latency grows
+    print(f"{'distance':>8} {'conc':>5} {'TPS':>9} {'p50 (ms)':>9} {'p99 (ms)':>9}")
+    for r in test_results:
+        print(f"{r['distance']:>8} {r['concurrency']:>5} {r['tps']:>9.1f} {r['p50']:>9.2f} {r['p99']:>9.2f}")
+
+def scheduler_benchmark(nodes=20, repetitions=3):
+    schedulers = ('heap', 'map', 'list', 'calendar')
+    # Same configuration for every scheduler: dense wifi PHY events, OLSR and TCP timers
+    run_app = ['./simulation3', '--height=100', '--maxBytes=1000000', '--distance=25', f'--nodes={nodes}',
+               '--layout=grid', '--routing=olsr']
+
+    test_results = []
+
+    for scheduler in schedulers:
+        for repetition in range(repetitions):
+            result = simulate(run_app + [f'--scheduler={scheduler}'])
+            test_results.append({
+                'scheduler': scheduler,
+                'repetition': repetition,
+                'events': result['simulator']['events'],
+                'wall_ms': result['simulator']['wall_ms'],
+                'events_per_s': result['simulator']['events_per_s'],
+                'command_line': run_app + [f'--scheduler={scheduler}'],
+                'raw_data': result
+            })
+    with open(f'scheduler_benchmark_{nodes}.json', 'w') as fp:
+        json.dump(test_results, fp)
+
+    # The fastest of the repetitions is the least disturbed by other processes
+    print(f"{'scheduler':>9} {'events':>10} {'wall (ms)':>10} {'events/s':>12}")
+    for scheduler in schedulers:
+        best = min((r for r in test_results if r['scheduler'] == scheduler), key=lambda r: r['wall_ms'])
+        print(f"{scheduler:>9} {best['events']:>10} {best['wall_ms']:>10.0f} {best['events_per_s']:>12.0f}")
+
+def memory_comparison():
+    node_counts = (10, 50, 100, 200, 500)
+
+    test_results = []
+
+    for lean in (False, True):
+        for nodes in node_counts:
+            run_app = ['./simulation3', '--height=100', '--maxBytes=100000', '--distance=25', f'--nodes={nodes}',
+                       '--layout=grid', '--routing=olsr', '--memory']
+            if lean:
+                run_app.append('--lean')
+            result = simulate(run_app)
+            test_results.append({
+                'lean': lean,
+                'nodes': nodes,
+                'bytes_per_node': result['memory']['bytes_per_node'],
+                'phases': {phase['phase']: phase['bytes'] for phase in result['memory']['phases']},
+                'command_line': run_app,
+                'raw_data': result
+            })
+    with open('memory_comparison.json', 'w') as fp:
+        json.dump(test_results, fp)
+
+    # kB per node and phase, the growth with the node count shows what does not scale linearly
+    phases = list(test_results[0]['phases'].keys())
+    print(f"{'lean':>5} {'nodes':>6} {'kB/node':>8} " + ' '.join(f'{phase:>12}' for phase in phases))
+    for r in test_results:
+        print(f"{str(r['lean']):>5} {r['nodes']:>6} {r['bytes_per_node'] / 1000:>8.1f} " +
+              ' '.join(f"{r['phases'][phase] / 1000 / r['nodes']:>12.1f}" for phase in phases))
+
+def energy_comparison(routing='static'):
+    configurations = (
+        ('802.11g 54M', ['--standard=g']),
+        ('802.11g 18M', ['--standard=g', '--rate_manager=constant', '--wifi_transmission_mode=ErpOfdmRate18Mbps']),
+        ('802.11g 6M', ['--standard=g', '--rate_manager=constant', '--wifi_transmission_mode=ErpOfdmRate6Mbps']),
+        ('802.11n A-MPDU', ['--standard=n-5']),
+        ('802.11ac A-MPDU', ['--standard=ac']),
+        ('802.11g UDP', ['--standard=g', '--socket_factory=ns3::UdpSocketFactory']),
+    )
+    hops = (1, 3, 5)
+    size = 1000000
+    start_time = 10260
+
+    test_results = []
+
+    for name, options in configurations:
+        for hop in hops:
+            run_app = ['./simulation3', '--height=100', f'--maxBytes={size}', '--distance=25',
+                       f'--nodes={hop + 1}', f'--routing={routing}', '--energy'] + options
+            result = simulate(run_app)
+            throughput = 0
+            if not result['rx_bytes_application'] == 0:
+                time_taken = (result['rx_ms_last'] - start_time) / 1000
+                throughput = (result['rx_bytes_application'] / 1000) / time_taken
+            test_results.append({
+                'configuration': name,
+                'hops': hop,
+                'throughput': throughput,
+                'uj_per_bit': result['energy']['j_per_bit'] * 1e6,
+                'max_node_j': result['energy']['max_node_energy_j'],
+                'command_line': run_app,
+                'raw_data': result
+            })
+    with open('energy_comparison.json', 'w') as fp:
+        json.dump(test_results, fp)
+
+    # The fastest configuration is not necessarily the one with the least energy per bit
+    print(f"{'configuration':>18} {'hops':>5} {'kB/s':>10} {'uJ/bit':>8} {'max node J':>11}")
+    for r in test_results:
+        print(f"{r['configuration']:>18} {r['hops']:>5} {r['throughput']:>10.1f} {r['uj_per_bit']:>8.3f} {r['max_node_j']:>11.2f}")
+
+def payload_transfer(payload_file, routing='olsr'):
+    hops = (1, 2, 3, 5, 7)
+
+    test_results = []
+
+    for hop in hops:
+        run_app = ['./simulation3', '--height=100', '--distance=25', f'--nodes={hop + 1}', f'--routing={routing}',
+                   f'--payload_file={payload_file}']
+        result = simulate(run_app)
+        test_results.append({
+            'hops': hop,
+            'verified': result['payload']['verified'],
+            'completion_ms': result['payload']['completion_ms'],
+            'command_line': run_app,
+            'raw_data': result
+        })
+    with open('payload_transfer.json', 'w') as fp:
+        json.dump(test_results, fp)
+
+    print(f"{'hops':>5} {'verified':>9} {'completion ms':>14}")
+    for r in test_results:
+        print(f"{r['hops']:>5} {str(r['verified']):>9} {r['completion_ms']:>14}")
+
+def phy_comparison(routing='static'):
+    configurations = (
+        ('single 1 hop', ['--nodes=2']),
+        ('single 3 hops', ['--nodes=4']),
+        ('single 5 hops', ['--nodes=6']),
+        ('multichannel 3 hops', ['--nodes=4', '--topology=multichannel', '--radio_channels=3']),
+        ('multichannel 5 hops', ['--nodes=6', '--topology=multichannel', '--radio_channels=3']),
+    )
+    size = 1000000
+    start_time = 10260
+
+    test_results = []
+
+    for name, options in configurations:
+        for phy in ('yans', 'spectrum'):
+            run_app = ['./simulation3', '--height=100', f'--maxBytes={size}', '--distance=25', f'--routing={routing}',
+                       f'--phy={phy}'] + options
+            result = simulate(run_app)
+            throughput = 0
+            if not result['rx_bytes_application'] == 0:
+                time_taken = (result['rx_ms_last'] - start_time) / 1000
+                throughput = (result['rx_bytes_application'] / 1000) / time_taken
+            test_results.append({
+                'configuration': name,
+                'phy': phy,
+                'throughput': throughput,
+                'wall_ms': result['simulator']['wall_ms'],
+                'events': result['simulator']['events'],
+                'command_line': run_app,
+                'raw_data': result
+            })
+    with open('phy_comparison.json', 'w') as fp:
+        json.dump(test_results, fp)
+
+    # Fidelity (throughput difference) against cost (slowdown) of the spectrum PHY
+    print(f"{'configuration':>20} {'phy':>9} {'kB/s':>10} {'wall ms':>9} {'events':>10} {'slowdown':>9}")
+    for r in test_results:
+        yans = [y for y in test_results if y['configuration'] == r['configuration'] and y['phy'] == 'yans'][0]
+        slowdown = r['wall_ms'] / yans['wall_ms'] if yans['wall_ms'] else 0
+        print(f"{r['configuration']:>20} {r['phy']:>9} {r['throughput']:>10.1f} {r['wall_ms']:>9} {r['events']:>10} {slowdown:>9.2f}")
+
+def wired_comparison(routing='static', data_rate='54Mbps', delay='1ms'):
+    # Same number of hops once over a chain of point-to-point links, once over the Wi-Fi mesh of simulation3
+    size = 1000000
+    start_time = 10260
+
+    test_results = []
+
+    for hops in range(1, 6):
+        run_app = ['./simulation1', f'--maxBytes={size}', '--topology=chain', f'--hops={hops}',
+                   f'--data_rate={data_rate}', f'--delay={delay}']
+        wired = simulate(run_app)
+        # The link direction with the fullest device queue is where the packets queue up
+        bottleneck = max(wired['links'], key=lambda link: link['max_queue_packets'])
+        test_results.append({
+            'hops': hops,
+            'network': 'p2p',
+            'throughput': wired['goodput_bps'] / 8 / 1000,
+            'bottleneck': f"{bottleneck['from']}->{bottleneck['to']}",
+            'max_queue': bottleneck['max_queue_packets'],
+            'command_line': run_app,
+            'raw_data': wired
+        })
+
+        run_app = ['./simulation3', '--height=100', f'--maxBytes={size}', '--distance=25', f'--routing={routing}',
+                   f'--nodes={hops + 1}']
+        wifi = simulate(run_app)
+        throughput = 0
+        if not wifi['rx_bytes_application'] == 0:
+            time_taken = (wifi['rx_ms_last'] - start_time) / 1000
+            throughput = (wifi['rx_bytes_application'] / 1000) / time_taken
+        test_results.append({
+            'hops': hops,
+            'network': 'wifi',
+            'throughput': throughput,
+            'bottleneck': '',
+            'max_queue': '',
+            'command_line': run_app,
+            'raw_data': wifi
+        })
+    with open('wired_comparison.json', 'w') as fp:
+        json.dump(test_results, fp)
+
+    print(f"{'hops':>5} {'network':>8} {'kB/s':>10} {'bottleneck':>11} {'max queue':>10}")
+    for r in test_results:
+        print(f"{r['hops']:>5} {r['network']:>8} {r['throughput']:>10.1f} {r['bottleneck']:>11} {r['max_queue']:>10}")
+
+def olsr_timer_sweep(nodes=6, mobility='static'):
+    # HELLO and TC intervals scaled together (TC = 2.5 HELLO, as with ns3's defaults), from aggressive to lazy
+    timers = ((250, 625), (500, 1250), (1000, 2500), (2000, 5000), (4000, 10000))
+    willingnesses = ('default', 'high')
+    size = 1000000
+    start_time = 10260
+
+    test_results = []
+
+    for hello, tc in timers:
+        for willingness in willingnesses:
+            run_app = ['./simulation3', '--height=100', f'--maxBytes={size}', '--distance=25', '--routing=olsr',
+                       f'--nodes={nodes}', f'--mobility={mobility}', f'--olsr_hello={hello}', f'--olsr_tc={tc}',
+                       f'--olsr_mid={tc}', f'--olsr_hna={tc}', f'--olsr_willingness={willingness}']
+            result = simulate(run_app)
+            throughput = 0
+            if not result['rx_bytes_application'] == 0:
+                time_taken = (result['rx_ms_last'] - start_time) / 1000
+                throughput = (result['rx_bytes_application'] / 1000) / time_taken
+            test_results.append({
+                'hello': hello,
+                'tc': tc,
+                'willingness': willingness,
+                'convergence_ms': result['olsr']['convergence_ms'],
+                'outages': result['olsr']['outages'],
+                'outage_max_ms': result['olsr']['outage_max_ms'],
+                'control': result['olsr']['control_bytes_per_s'],
+                'throughput': throughput,
+                'command_line': run_app,
+                'raw_data': result
+            })
+    with open(f'olsr_timer_sweep_{nodes}_{mobility}.json', 'w') as fp:
+        json.dump(test_results, fp)
+
+    print(f"{'hello':>6} {'tc':>6} {'willingness':>11} {'conv ms':>8} {'outages':>8} {'max ms':>7} {'ctrl B/s':>9} {'kB/s':>8}")
+    for r in test_results:
+        print(f"{r['hello']:>6} {r['tc']:>6} {r['willingness']:>11} {r['convergence_ms']:>8} {r['outages']:>8} "
+              f"{r['outage_max_ms']:>7} {r['control']:>9.1f} {r['throughput']:>8.1f}")
+
 def map_on_index(element, iterable):
     for i in range(0, len(iterable)):
         if int(element) == int(iterable[i]):
@@ -343,5 +1005,93 @@ def main():
         )
     elif sys.argv[1] == 'olsrgraph':
         olsr_graph('olsr.csv')
+    elif sys.argv[1] == 'routingcompare':
+        if len(sys.argv) > 2:
+            routing_comparison(sys.argv[2])
+        else:
+            routing_comparison()
+    elif sys.argv[1] == 'routingcomparegraph':
+        routing_comparison_graph()
+    elif sys.argv[1] == 'aggregationcompare':
+        aggregation_comparison()
+    elif sys.argv[1] == 'aggregationcomparegraph':
+        aggregation_comparison_graph()
+    elif sys.argv[1] == 'multichannelcompare':
+        if len(sys.argv) > 2:
+            multichannel_comparison(sys.argv[2])
+        else:
+            multichannel_comparison()
+    elif sys.argv[1] == 'multichannelcomparegraph':
+        multichannel_comparison_graph()
+    elif sys.argv[1] == 'backhaulcompare':
+        if len(sys.argv) > 2:
+            backhaul_comparison(sys.argv[2])
+        else:
+            backhaul_comparison()
+    elif sys.argv[1] == 'backhaulcomparegraph':
+        backhaul_comparison_graph()
+    elif sys.argv[1] == 'aqmcompare':
+        if len(sys.argv) > 2:
+            aqm_comparison(sys.argv[2])
+        else:
+            aqm_comparison()
+    elif sys.argv[1] == 'rtsctscompare':
+        if len(sys.argv) > 2:
+            rts_cts_comparison(sys.argv[2])
+        else:
+            rts_cts_comparison()
+    elif sys.argv[1] == 'tcpvariantcompare':
+        if len(sys.argv) > 2:
+            tcp_variant_comparison(sys.argv[2])
+        else:
+            tcp_variant_comparison()
+    elif sys.argv[1] == 'tcpvariantcomparegraph':
+        tcp_variant_comparison_graph()
+    elif sys.argv[1] == 'parallelcompare':
+        if len(sys.argv) > 2:
+            parallel_comparison(sys.argv[2])
+        else:
+            parallel_comparison()
+    elif sys.argv[1] == 'parallelcomparegraph':
+        parallel_comparison_graph()
+    elif sys.argv[1] == 'rrcompare':
+        if len(sys.argv) > 2:
+            request_response_comparison(sys.argv[2])
+        else:
+            request_response_comparison()
+    elif sys.argv[1] == 'schedulerbench':
+        if len(sys.argv) > 2:
+            scheduler_benchmark(int(sys.argv[2]))
+        else:
+            scheduler_benchmark()
+    elif sys.argv[1] == 'memorycompare':
+        memory_comparison()
+    elif sys.argv[1] == 'payload':
+        if len(sys.argv) > 3:
+            payload_transfer(sys.argv[2], sys.argv[3])
+        else:
+            payload_transfer(sys.argv[2])
+    elif sys.argv[1] == 'phycompare':
+        if len(sys.argv) > 2:
+            phy_comparison(sys.argv[2])
+        else:
+            phy_comparison()
+    elif sys.argv[1] == 'wiredcompare':
+        if len(sys.argv) > 2:
+            wired_comparison(sys.argv[2])
+        else:
+            wired_comparison()
+    elif sys.argv[1] == 'olsrsweep':
+        if len(sys.argv) > 3:
+            olsr_timer_sweep(int(sys.argv[2]), sys.argv[3])
+        elif len(sys.argv) > 2:
+            olsr_timer_sweep(int(sys.argv[2]))
+        else:
+            olsr_timer_sweep()
+    elif sys.argv[1] == 'energycompare':
+        if len(sys.argv) > 2:
+            energy_comparison(sys.argv[2])
+        else:
+            energy_comparison()
 
 main()
\ No newline at end of file
@@ -0,0 +1,317 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2006,2007 INRIA
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Mathieu Lacage, <mathieu.lacage@sophia.inria.fr>
+ */
+
+// Kommunikation in verteilten Systemen - Spatially culled wifi channel
+// This code was adapted from ns3's yans-wifi-channel code.
+// Instead of looping over all PHYs for every frame, only the PHYs inside the 27 grid cells around the sender
+// are looked at, and receptions are only scheduled for those which are above their CCA/energy detection threshold.
+
+#include <algorithm>
+#include <cmath>
+#include <set>
+#include "ns3/log.h"
+#include "ns3/double.h"
+#include "ns3/pointer.h"
+#include "ns3/simulator.h"
+#include "ns3/node.h"
+#include "ns3/net-device.h"
+#include "ns3/packet.h"
+#include "ns3/mobility-model.h"
+#include "ns3/constant-position-mobility-model.h"
+#include "ns3/propagation-loss-model.h"
+#include "ns3/propagation-delay-model.h"
+#include "ns3/wifi-utils.h"
+#include "grid-wifi-phy.h"
+#include "grid-wifi-channel.h"
+
+namespace ns3 {
+
+    NS_LOG_COMPONENT_DEFINE ("GridWifiChannel");
+
+    NS_OBJECT_ENSURE_REGISTERED (GridWifiChannel);
+
+    TypeId
+    GridWifiChannel::GetTypeId(void) {
+        static TypeId tid = TypeId("ns3::GridWifiChannel")
+                .SetParent<Channel>()
+                .SetGroupName("Wifi")
+                .AddConstructor<GridWifiChannel>()
+                .AddAttribute("PropagationLossModel", "A pointer to the propagation loss model attached to this channel.",
+                              PointerValue(),
+                              MakePointerAccessor(&GridWifiChannel::m_loss),
+                              MakePointerChecker<PropagationLossModel>())
+                .AddAttribute("PropagationDelayModel", "A pointer to the propagation delay model attached to this channel.",
+                              PointerValue(),
+                              MakePointerAccessor(&GridWifiChannel::m_delay),
+                              MakePointerChecker<PropagationDelayModel>())
+                .AddAttribute("CullingMargin",
+                              "Also deliver signals which are up to this many dB below the CCA mode 1 (or, if lower, "
+                              "the energy detection) threshold of the receiver, so that they count as interference.",
+                              DoubleValue(0.0),
+                              MakeDoubleAccessor(&GridWifiChannel::m_cullingMargin),
+                              MakeDoubleChecker<double>(0.0));
+        return tid;
+    }
+
+    GridWifiChannel::GridWifiChannel()
+            : m_cullingMargin(0.0),
+              m_gridValid(false),
+              m_gridTxPowerDbm(0.0),
+              m_cellSize(0.0),
+              m_scheduled(0),
+              m_culled(0) {
+        NS_LOG_FUNCTION (this);
+    }
+
+    GridWifiChannel::~GridWifiChannel() {
+        NS_LOG_FUNCTION (this);
+    }
+
+    void
+    GridWifiChannel::DoDispose(void) {
+        NS_LOG_FUNCTION (this);
+        m_phyList.clear();
+        m_grid.clear();
+        m_mobile.clear();
+        m_loss = 0;
+        m_delay = 0;
+        Channel::DoDispose();
+    }
+
+    std::size_t
+    GridWifiChannel::GetNDevices(void) const {
+        return m_phyList.size();
+    }
+
+    Ptr<NetDevice>
+    GridWifiChannel::GetDevice(std::size_t i) const {
+        return m_phyList[i]->GetDevice()->GetObject<NetDevice>();
+    }
+
+    void
+    GridWifiChannel::Add(Ptr<GridWifiPhy> phy) {
+        NS_LOG_FUNCTION (this << phy);
+        m_phyList.push_back(phy);
+        m_gridValid = false;
+    }
+
+    void
+    GridWifiChannel::SetPropagationLossModel(const Ptr<PropagationLossModel> loss) {
+        m_loss = loss;
+        m_gridValid = false;
+    }
+
+    void
+    GridWifiChannel::SetPropagationDelayModel(const Ptr<PropagationDelayModel> delay) {
+        m_delay = delay;
+    }
+
+    bool
+    GridWifiChannel::Cell::operator<(const Cell &other) const {
+        if (x != other.x) {
+            return x < other.x;
+        }
+        if (y != other.y) {
+            return y < other.y;
+        }
+        return z < other.z;
+    }
+
+    GridWifiChannel::Cell
+    GridWifiChannel::GetCell(const Vector &position) const {
+        Cell cell;
+        cell.x = static_cast<int64_t>(std::floor(position.x / m_cellSize));
+        cell.y = static_cast<int64_t>(std::floor(position.y / m_cellSize));
+        cell.z = static_cast<int64_t>(std::floor(position.z / m_cellSize));
+        return cell;
+    }
+
+    double
+    GridWifiChannel::GetRange(Ptr<PropagationLossModel> loss, double txPowerDbm, double rxPowerDbm,
+                              double txHeight, double rxHeight) {
+        // Loss models like ItuR1411Los depend on the antenna heights, so the ends are placed at their real heights
+        Ptr<ConstantPositionMobilityModel> a = CreateObject<ConstantPositionMobilityModel>();
+        Ptr<ConstantPositionMobilityModel> b = CreateObject<ConstantPositionMobilityModel>();
+        a->SetPosition(Vector(0.0, 0.0, txHeight));
+
+        // Find an upper bound first, then bisect
+        double lower = 0.0;
+        double upper = 1.0;
+        b->SetPosition(Vector(upper, 0.0, rxHeight));
+        while (loss->CalcRxPower(txPowerDbm, a, b) >= rxPowerDbm) {
+            lower = upper;
+            upper *= 2;
+            if (upper > 1e7) {
+                NS_FATAL_ERROR ("GridWifiChannel: Transmissions reach further than 10000km, is the loss model monotonic?");
+            }
+            b->SetPosition(Vector(upper, 0.0, rxHeight));
+        }
+        while (upper - lower > 0.01) {
+            double middle = (lower + upper) / 2;
+            b->SetPosition(Vector(middle, 0.0, rxHeight));
+            if (loss->CalcRxPower(txPowerDbm, a, b) >= rxPowerDbm) {
+                lower = middle;
+            } else {
+                upper = middle;
+            }
+        }
+        return upper;
+    }
+
+    double
+    GridWifiChannel::GetThreshold(Ptr<GridWifiPhy> phy) const {
+        // YansWifiPhy goes CCA busy (and accounts the signal as interference) at CcaMode1Threshold,
+        // which is below the energy detection threshold with ns3's defaults (-99 dBm vs. -96 dBm)
+        double thresholdDbm = std::min(phy->GetEdThreshold(), phy->GetCcaMode1Threshold());
+        return thresholdDbm - phy->GetRxGain() - m_cullingMargin;
+    }
+
+    void
+    GridWifiChannel::UpdateGrid(double txPowerDbm) {
+        if (m_gridValid && txPowerDbm <= m_gridTxPowerDbm) {
+            return;
+        }
+
+        // The weakest signal which has to be delivered
+        double thresholdDbm = 0.0;
+        for (PhyList::const_iterator i = m_phyList.begin(); i != m_phyList.end(); ++i) {
+            double phyThresholdDbm = GetThreshold(*i);
+            if (i == m_phyList.begin() || phyThresholdDbm < thresholdDbm) {
+                thresholdDbm = phyThresholdDbm;
+            }
+        }
+
+        m_gridTxPowerDbm = std::max(txPowerDbm, m_gridValid ? m_gridTxPowerDbm : txPowerDbm);
+
+        // The cells must cover the range between any pair of heights the PHYs are located at
+        std::set<double> heights;
+        for (PhyList::const_iterator i = m_phyList.begin(); i != m_phyList.end(); ++i) {
+            heights.insert((*i)->GetMobility()->GetPosition().z);
+        }
+        m_cellSize = 0.0;
+        for (std::set<double>::const_iterator tx = heights.begin(); tx != heights.end(); ++tx) {
+            for (std::set<double>::const_iterator rx = heights.begin(); rx != heights.end(); ++rx) {
+                // A receiver right above the sender must lie inside a neighbouring cell as well
+                m_cellSize = std::max(m_cellSize, std::fabs(*tx - *rx));
+                m_cellSize = std::max(m_cellSize, GetRange(m_loss, m_gridTxPowerDbm, thresholdDbm, *tx, *rx));
+            }
+        }
+        NS_LOG_INFO ("Cell size is " << m_cellSize << "m for " << m_gridTxPowerDbm << "dBm");
+
+        m_grid.clear();
+        m_mobile.clear();
+        for (PhyList::const_iterator i = m_phyList.begin(); i != m_phyList.end(); ++i) {
+            Ptr<MobilityModel> mobility = (*i)->GetMobility();
+            if (DynamicCast<ConstantPositionMobilityModel>(mobility)) {
+                m_grid[GetCell(mobility->GetPosition())].push_back(*i);
+            } else {
+                m_mobile.push_back(*i);
+            }
+        }
+        m_gridValid = true;
+    }
+
+    void
+    GridWifiChannel::Send(Ptr<GridWifiPhy> sender, Ptr<const Packet> packet, double txPowerDbm, Time duration) {
+        NS_LOG_FUNCTION (this << sender << packet << txPowerDbm << duration.GetSeconds());
+        UpdateGrid(txPowerDbm);
+
+        Ptr<MobilityModel> senderMobility = sender->GetMobility();
+        NS_ASSERT (senderMobility != 0);
+        Cell center = GetCell(senderMobility->GetPosition());
+
+        Cell cell;
+        for (cell.x = center.x - 1; cell.x <= center.x + 1; ++cell.x) {
+            for (cell.y = center.y - 1; cell.y <= center.y + 1; ++cell.y) {
+                for (cell.z = center.z - 1; cell.z <= center.z + 1; ++cell.z) {
+                    std::map<Cell, PhyList>::const_iterator phys = m_grid.find(cell);
+                    if (phys == m_grid.end()) {
+                        continue;
+                    }
+                    for (PhyList::const_iterator i = phys->second.begin(); i != phys->second.end(); ++i) {
+                        Deliver(sender, senderMobility, *i, packet, txPowerDbm, duration);
+                    }
+                }
+            }
+        }
+        for (PhyList::const_iterator i = m_mobile.begin(); i != m_mobile.end(); ++i) {
+            Deliver(sender, senderMobility, *i, packet, txPowerDbm, duration);
+        }
+    }
+
+    void
+    GridWifiChannel::Deliver(Ptr<GridWifiPhy> sender, Ptr<MobilityModel> senderMobility, Ptr<GridWifiPhy> receiver,
+                             Ptr<const Packet> packet, double txPowerDbm, Time duration) {
+        if (receiver == sender) {
+            return;
+        }
+        // Like YansWifiChannel, neither inter channel interference nor channel bonding is accounted for
+        if (receiver->GetChannelNumber() != sender->GetChannelNumber()) {
+            return;
+        }
+
+        Ptr<MobilityModel> receiverMobility = receiver->GetMobility();
+        double rxPowerDbm = m_loss->CalcRxPower(txPowerDbm, senderMobility, receiverMobility);
+        if (rxPowerDbm < GetThreshold(receiver)) {
+            m_culled++;
+            return;
+        }
+
+        Time delay = m_delay->GetDelay(senderMobility, receiverMobility);
+        NS_LOG_DEBUG ("propagation: txPower=" << txPowerDbm << "dbm, rxPower=" << rxPowerDbm << "dbm, " <<
+                      "distance=" << senderMobility->GetDistanceFrom(receiverMobility) << "m, delay=" << delay);
+
+        Ptr<Packet> copy = packet->Copy();
+        Ptr<NetDevice> dstNetDevice = receiver->GetDevice();
+        uint32_t dstNode;
+        if (dstNetDevice == 0) {
+            dstNode = 0xffffffff;
+        } else {
+            dstNode = dstNetDevice->GetNode()->GetId();
+        }
+        m_scheduled++;
+        Simulator::ScheduleWithContext(dstNode, delay, &GridWifiChannel::Receive,
+                                       receiver, copy, rxPowerDbm, duration);
+    }
+
+    void
+    GridWifiChannel::Receive(Ptr<GridWifiPhy> receiver, Ptr<Packet> packet, double rxPowerDbm, Time duration) {
+        NS_LOG_FUNCTION (receiver << packet << rxPowerDbm << duration.GetSeconds());
+        receiver->StartReceivePreamble(packet, DbmToW(rxPowerDbm + receiver->GetRxGain()), duration);
+    }
+
+    uint64_t
+    GridWifiChannel::GetScheduledReceptions(void) const {
+        return m_scheduled;
+    }
+
+    uint64_t
+    GridWifiChannel::GetCulledReceptions(void) const {
+        return m_culled;
+    }
+
+    int64_t
+    GridWifiChannel::AssignStreams(int64_t stream) {
+        int64_t currentStream = stream;
+        currentStream += m_loss->AssignStreams(stream);
+        return (currentStream - stream);
+    }
+
+} // namespace ns3
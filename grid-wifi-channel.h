@@ -0,0 +1,217 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2006,2007 INRIA
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Mathieu Lacage, <mathieu.lacage@sophia.inria.fr>
+ */
+
+#ifndef GRID_WIFI_CHANNEL_H
+#define GRID_WIFI_CHANNEL_H
+
+#include <map>
+#include <vector>
+#include "ns3/channel.h"
+#include "ns3/nstime.h"
+#include "ns3/vector.h"
+
+namespace ns3 {
+
+    class NetDevice;
+    class Packet;
+    class PropagationLossModel;
+    class PropagationDelayModel;
+    class MobilityModel;
+    class GridWifiPhy;
+
+/**
+ * \brief A channel like YansWifiChannel which only delivers frames to PHYs in reach of the sender.
+ *
+ * YansWifiChannel schedules a reception event on every PHY attached to the
+ * channel for every transmitted frame, even if the PHY discards it right away
+ * because it is far below its energy detection threshold. This channel keeps
+ * the positions of the attached PHYs in a grid of cubic cells instead. The edge
+ * length of a cell equals the maximum range of a transmission, i.e. the
+ * distance at which the received power drops below the lowest threshold of all
+ * PHYs (minus CullingMargin). Only the PHYs in the cell of the sender and its 26
+ * neighbours are considered, and only those whose received power is above their
+ * threshold get a reception event. The threshold of a PHY is the lower of its
+ * energy detection and CCA mode 1 thresholds: YansWifiPhy already senses the
+ * channel busy and accounts interference for signals below energy detection.
+ *
+ * The range is found by bisection on the propagation loss model, which must
+ * therefore be deterministic and monotonic in distance (e.g.
+ * ItuR1411LosPropagationLossModel), for every pair of heights the PHYs are
+ * located at when the grid is built. PHYs whose mobility model is not a
+ * ConstantPositionMobilityModel are checked on every transmission.
+ *
+ * Note that signals below the CCA threshold still add to the interference of
+ * a YansWifiChannel. A positive CullingMargin keeps delivering those weak signals.
+ */
+    class GridWifiChannel : public Channel {
+    public:
+        /**
+         * \brief Get the type ID.
+         * \return the object TypeId
+         */
+        static TypeId GetTypeId(void);
+
+        GridWifiChannel();
+
+        virtual ~GridWifiChannel();
+
+        // Inherited from Channel
+        virtual std::size_t GetNDevices(void) const;
+
+        virtual Ptr<NetDevice> GetDevice(std::size_t i) const;
+
+        /**
+         * Add the PHY to the list of PHYs attached to this channel.
+         *
+         * \param phy the PHY to attach
+         */
+        void Add(Ptr<GridWifiPhy> phy);
+
+        /**
+         * \param loss the new propagation loss model
+         */
+        void SetPropagationLossModel(const Ptr<PropagationLossModel> loss);
+
+        /**
+         * \param delay the new propagation delay model
+         */
+        void SetPropagationDelayModel(const Ptr<PropagationDelayModel> delay);
+
+        /**
+         * Deliver the frame to every PHY in reach of the sender.
+         *
+         * \param sender the PHY which transmits the frame
+         * \param packet the frame
+         * \param txPowerDbm the transmission power in dBm (including the antenna gain)
+         * \param duration the duration of the transmission
+         */
+        void Send(Ptr<GridWifiPhy> sender, Ptr<const Packet> packet, double txPowerDbm, Time duration);
+
+        /**
+         * Compute the horizontal distance at which a transmission drops below a certain power.
+         *
+         * \param loss the propagation loss model, which must be deterministic and monotonic in distance
+         * \param txPowerDbm the transmission power in dBm
+         * \param rxPowerDbm the minimum received power in dBm
+         * \param txHeight the height of the transmitter in m
+         * \param rxHeight the height of the receiver in m
+         * \return the maximum horizontal distance in m at which the received power is at least rxPowerDbm
+         */
+        static double GetRange(Ptr<PropagationLossModel> loss, double txPowerDbm, double rxPowerDbm,
+                               double txHeight, double rxHeight);
+
+        /**
+         * \return the number of receptions which were scheduled
+         */
+        uint64_t GetScheduledReceptions(void) const;
+
+        /**
+         * \return the number of receptions which were left out, because the receiver was out of reach
+         */
+        uint64_t GetCulledReceptions(void) const;
+
+        /**
+         * Assign a fixed random variable stream number to the random variables
+         * used by the propagation loss model.
+         *
+         * \param stream first stream index to use
+         * \return the number of stream indices assigned by this model
+         */
+        int64_t AssignStreams(int64_t stream);
+
+    protected:
+        virtual void DoDispose(void);
+
+    private:
+        /// Index of a cell of the grid
+        struct Cell {
+            int64_t x;  //!< Index along the x axis
+            int64_t y;  //!< Index along the y axis
+            int64_t z;  //!< Index along the z axis
+
+            /**
+             * \param other the cell to compare to
+             * \return true if this cell is ordered before the other one
+             */
+            bool operator<(const Cell &other) const;
+        };
+
+        /**
+         * \param position a position
+         * \return the cell the position is located in
+         */
+        Cell GetCell(const Vector &position) const;
+
+        /**
+         * \param phy a PHY attached to this channel
+         * \return the weakest signal (received power in dBm, before the antenna gain of the PHY) to deliver
+         */
+        double GetThreshold(Ptr<GridWifiPhy> phy) const;
+
+        /**
+         * (Re-)build the grid if PHYs were added or the range of transmissions grew.
+         *
+         * \param txPowerDbm the transmission power of the frame about to be sent
+         */
+        void UpdateGrid(double txPowerDbm);
+
+        /**
+         * Schedule the reception of the frame if the receiver is in reach.
+         *
+         * \param sender the PHY which transmits the frame
+         * \param senderMobility the mobility model of the sender
+         * \param receiver the PHY which might receive the frame
+         * \param packet the frame
+         * \param txPowerDbm the transmission power in dBm (including the antenna gain)
+         * \param duration the duration of the transmission
+         */
+        void Deliver(Ptr<GridWifiPhy> sender, Ptr<MobilityModel> senderMobility, Ptr<GridWifiPhy> receiver,
+                     Ptr<const Packet> packet, double txPowerDbm, Time duration);
+
+        /**
+         * Start receiving the frame.
+         *
+         * \param receiver the receiving PHY
+         * \param packet the frame
+         * \param rxPowerDbm the received power in dBm (without the antenna gain of the receiver)
+         * \param duration the duration of the transmission
+         */
+        static void Receive(Ptr<GridWifiPhy> receiver, Ptr<Packet> packet, double rxPowerDbm, Time duration);
+
+        typedef std::vector<Ptr<GridWifiPhy> > PhyList; //!< A list of PHYs
+
+        PhyList m_phyList;                      //!< All PHYs attached to this channel
+        Ptr<PropagationLossModel> m_loss;       //!< Propagation loss model
+        Ptr<PropagationDelayModel> m_delay;     //!< Propagation delay model
+        double m_cullingMargin;                 //!< Deliver signals down to this many dB below the threshold
+
+        bool m_gridValid;                       //!< False if the grid has to be rebuilt
+        double m_gridTxPowerDbm;                //!< Transmission power the cells have been sized for
+        double m_cellSize;                      //!< Edge length of a cell in m
+        std::map<Cell, PhyList> m_grid;         //!< PHYs with constant position, sorted into cells
+        PhyList m_mobile;                       //!< PHYs which may move, always checked
+
+        uint64_t m_scheduled;                   //!< Number of scheduled receptions
+        uint64_t m_culled;                      //!< Number of receptions left out
+    };
+
+} // namespace ns3
+
+#endif /* GRID_WIFI_CHANNEL_H */
@@ -0,0 +1,54 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2008 INRIA
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Mathieu Lacage <mathieu.lacage@sophia.inria.fr>
+ */
+
+#include "ns3/error-rate-model.h"
+#include "grid-wifi-phy.h"
+#include "grid-wifi-helper.h"
+
+namespace ns3 {
+
+    GridWifiPhyHelper::GridWifiPhyHelper()
+            : m_channel(0) {
+        m_phy.SetTypeId("ns3::GridWifiPhy");
+    }
+
+    GridWifiPhyHelper
+    GridWifiPhyHelper::Default(void) {
+        GridWifiPhyHelper helper;
+        helper.SetErrorRateModel("ns3::NistErrorRateModel");
+        return helper;
+    }
+
+    void
+    GridWifiPhyHelper::SetChannel(Ptr<GridWifiChannel> channel) {
+        m_channel = channel;
+    }
+
+    Ptr<WifiPhy>
+    GridWifiPhyHelper::Create(Ptr<Node> node, Ptr<NetDevice> device) const {
+        Ptr<GridWifiPhy> phy = m_phy.Create<GridWifiPhy>();
+        Ptr<ErrorRateModel> error = m_errorRateModel.Create<ErrorRateModel>();
+        phy->SetErrorRateModel(error);
+        phy->SetChannel(m_channel);
+        phy->SetDevice(device);
+        return phy;
+    }
+
+} // namespace ns3
@@ -0,0 +1,69 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2008 INRIA
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Mathieu Lacage <mathieu.lacage@sophia.inria.fr>
+ */
+
+#ifndef GRID_WIFI_HELPER_H
+#define GRID_WIFI_HELPER_H
+
+#include "ns3/wifi-helper.h"
+#include "grid-wifi-channel.h"
+
+namespace ns3 {
+
+/**
+ * \brief Make it easy to create and manage PHY objects for the GridWifiChannel.
+ *
+ * This works like YansWifiPhyHelper, so pcap and ascii tracing are available as usual.
+ */
+    class GridWifiPhyHelper : public WifiPhyHelper {
+    public:
+        /**
+         * Create a phy helper without any parameter set. The user must set
+         * them all to be able to call Install later.
+         */
+        GridWifiPhyHelper();
+
+        /**
+         * Create a phy helper in a default working state.
+         *
+         * \returns a default GridWifiPhyHelper
+         */
+        static GridWifiPhyHelper Default(void);
+
+        /**
+         * \param channel the channel to associate to this helper
+         *
+         * Every PHY created by a call to Install is associated to this channel.
+         */
+        void SetChannel(Ptr<GridWifiChannel> channel);
+
+    private:
+        /**
+         * \param node the node on which we wish to create a wifi PHY
+         * \param device the device within which this PHY will be created
+         * \returns a newly-created PHY object.
+         */
+        virtual Ptr<WifiPhy> Create(Ptr<Node> node, Ptr<NetDevice> device) const;
+
+        Ptr<GridWifiChannel> m_channel; //!< GridWifiChannel that all PHYs are attached to
+    };
+
+} // namespace ns3
+
+#endif /* GRID_WIFI_HELPER_H */
@@ -0,0 +1,76 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2005,2006 INRIA
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Mathieu Lacage <mathieu.lacage@sophia.inria.fr>
+ */
+
+// Kommunikation in verteilten Systemen - Spatially culled wifi channel
+// This code was adapted from ns3's yans-wifi-phy code.
+
+#include "ns3/log.h"
+#include "grid-wifi-channel.h"
+#include "grid-wifi-phy.h"
+
+namespace ns3 {
+
+    NS_LOG_COMPONENT_DEFINE ("GridWifiPhy");
+
+    NS_OBJECT_ENSURE_REGISTERED (GridWifiPhy);
+
+    TypeId
+    GridWifiPhy::GetTypeId(void) {
+        static TypeId tid = TypeId("ns3::GridWifiPhy")
+                .SetParent<WifiPhy>()
+                .SetGroupName("Wifi")
+                .AddConstructor<GridWifiPhy>();
+        return tid;
+    }
+
+    GridWifiPhy::GridWifiPhy() {
+        NS_LOG_FUNCTION (this);
+    }
+
+    GridWifiPhy::~GridWifiPhy() {
+        NS_LOG_FUNCTION (this);
+    }
+
+    void
+    GridWifiPhy::DoDispose(void) {
+        NS_LOG_FUNCTION (this);
+        m_channel = 0;
+        WifiPhy::DoDispose();
+    }
+
+    Ptr<Channel>
+    GridWifiPhy::GetChannel(void) const {
+        return m_channel;
+    }
+
+    void
+    GridWifiPhy::SetChannel(const Ptr<GridWifiChannel> channel) {
+        NS_LOG_FUNCTION (this << channel);
+        m_channel = channel;
+        m_channel->Add(this);
+    }
+
+    void
+    GridWifiPhy::StartTx(Ptr<Packet> packet, WifiTxVector txVector, Time txDuration) {
+        NS_LOG_DEBUG ("Start transmission: signal power before antenna gain=" << GetPowerDbm(txVector.GetTxPowerLevel()) << "dBm");
+        m_channel->Send(this, packet, GetPowerDbm(txVector.GetTxPowerLevel()) + GetTxGain(), txDuration);
+    }
+
+} // namespace ns3
@@ -0,0 +1,70 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2005,2006 INRIA
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Mathieu Lacage <mathieu.lacage@sophia.inria.fr>
+ */
+
+#ifndef GRID_WIFI_PHY_H
+#define GRID_WIFI_PHY_H
+
+#include "ns3/wifi-phy.h"
+
+namespace ns3 {
+
+    class GridWifiChannel;
+
+/**
+ * \brief A WifiPhy attached to a GridWifiChannel.
+ *
+ * This is the same as YansWifiPhy, except that it transmits through a
+ * GridWifiChannel. YansWifiPhy can not be used for that, as it only accepts
+ * a YansWifiChannel.
+ */
+    class GridWifiPhy : public WifiPhy {
+    public:
+        /**
+         * \brief Get the type ID.
+         * \return the object TypeId
+         */
+        static TypeId GetTypeId(void);
+
+        GridWifiPhy();
+
+        virtual ~GridWifiPhy();
+
+        // Inherited from WifiPhy
+        virtual Ptr<Channel> GetChannel(void) const;
+
+        virtual void StartTx(Ptr<Packet> packet, WifiTxVector txVector, Time txDuration);
+
+        /**
+         * Set the GridWifiChannel this GridWifiPhy is to be connected to.
+         *
+         * \param channel the GridWifiChannel this GridWifiPhy is to be connected to
+         */
+        void SetChannel(const Ptr<GridWifiChannel> channel);
+
+    protected:
+        virtual void DoDispose(void);
+
+    private:
+        Ptr<GridWifiChannel> m_channel; //!< GridWifiChannel that this GridWifiPhy is connected to
+    };
+
+} // namespace ns3
+
+#endif /* GRID_WIFI_PHY_H */
@@ -0,0 +1,92 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// Kommunikation in verteilten Systemen - Latency probe
+// The probe uses ns3's V4Ping application, which reports the RTT of every echo reply through its "Rtt" trace.
+
+#include <algorithm>
+#include <cmath>
+#include "ns3/log.h"
+#include "ns3/callback.h"
+#include "ns3/application-container.h"
+#include "ns3/v4ping.h"
+#include "ns3/v4ping-helper.h"
+#include "latency-probe.h"
+
+namespace ns3 {
+
+    NS_LOG_COMPONENT_DEFINE ("LatencyProbe");
+
+    LatencyProbe::LatencyProbe()
+            : m_requests(0) {
+    }
+
+    void
+    LatencyProbe::Install(Ptr<Node> node, Ipv4Address remote, Time interval, Time start, Time stop) {
+        NS_ASSERT_MSG (interval.IsStrictlyPositive(), "The probe interval must be positive");
+
+        V4PingHelper ping(remote);
+        ping.SetAttribute("Interval", TimeValue(interval));
+        ApplicationContainer apps = ping.Install(node);
+        apps.Start(start);
+        apps.Stop(stop);
+
+        // Do not reallocate while the simulation is running
+        m_requests = (uint64_t) std::ceil((stop - start).GetSeconds() / interval.GetSeconds());
+        m_rtts.reserve(m_requests);
+        apps.Get(0)->TraceConnectWithoutContext("Rtt", MakeBoundCallback(&LatencyProbe::Rtt, this));
+    }
+
+    void
+    LatencyProbe::Rtt(LatencyProbe *probe, Time rtt) {
+        probe->m_rtts.push_back(rtt);
+    }
+
+    double
+    LatencyProbe::GetPercentile(const std::vector<Time> &sorted, double percentile) {
+        if (sorted.empty()) {
+            return 0.0;
+        }
+        size_t index = std::min(sorted.size() - 1, (size_t) (percentile / 100.0 * sorted.size()));
+        return sorted[index].GetSeconds() * 1000.0;
+    }
+
+    void
+    LatencyProbe::PrintJson(std::ostream &os) const {
+        std::vector<Time> sorted(m_rtts);
+        std::sort(sorted.begin(), sorted.end());
+
+        Time sum;
+        for (std::vector<Time>::const_iterator i = sorted.begin(); i != sorted.end(); ++i) {
+            sum += *i;
+        }
+        double average = sorted.empty() ? 0.0 : sum.GetSeconds() * 1000.0 / sorted.size();
+        double minimum = GetPercentile(sorted, 0.0);
+
+        os << "{";
+        os << "\"requests\":" << m_requests << ",";
+        os << "\"replies\":" << sorted.size() << ",";
+        os << "\"rtt_min_ms\":" << minimum << ",";
+        os << "\"rtt_avg_ms\":" << average << ",";
+        os << "\"rtt_p50_ms\":" << GetPercentile(sorted, 50.0) << ",";
+        os << "\"rtt_p95_ms\":" << GetPercentile(sorted, 95.0) << ",";
+        os << "\"rtt_p99_ms\":" << GetPercentile(sorted, 99.0) << ",";
+        os << "\"rtt_max_ms\":" << GetPercentile(sorted, 100.0) << ",";
+        os << "\"queueing_delay_avg_ms\":" << average - minimum;
+        os << "}";
+    }
+
+} // namespace ns3
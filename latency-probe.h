@@ -0,0 +1,79 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef LATENCY_PROBE_H
+#define LATENCY_PROBE_H
+
+#include <ostream>
+#include <vector>
+#include "ns3/nstime.h"
+#include "ns3/node.h"
+#include "ns3/ipv4-address.h"
+
+namespace ns3 {
+
+/**
+ * \brief A ping flow running next to the transfer under test, recording the round trip times.
+ *
+ * The RTT of the probes rises with the queues building up along the path. The
+ * smallest RTT measured is taken as the RTT of the idle path, the difference of
+ * the other RTTs to it is the queueing delay.
+ */
+    class LatencyProbe {
+    public:
+        LatencyProbe();
+
+        /**
+         * Install a V4Ping application sending one echo request per interval.
+         *
+         * \param node the node sending the echo requests
+         * \param remote the address of the node to ping
+         * \param interval the time between two echo requests
+         * \param start the time to send the first echo request
+         * \param stop the time to stop pinging
+         */
+        void Install(Ptr<Node> node, Ipv4Address remote, Time interval, Time start, Time stop);
+
+        /**
+         * Print the number of replies and the RTT distribution as JSON object.
+         *
+         * \param os the stream to print to
+         */
+        void PrintJson(std::ostream &os) const;
+
+    private:
+        /**
+         * Trace sink for the V4Ping "Rtt" trace source.
+         *
+         * \param probe the probe the reply belongs to
+         * \param rtt the round trip time of the echo request
+         */
+        static void Rtt(LatencyProbe *probe, Time rtt);
+
+        /**
+         * \param sorted the RTTs in ascending order
+         * \param percentile the percentile to compute (0..100)
+         * \return the RTT at the percentile in ms
+         */
+        static double GetPercentile(const std::vector<Time> &sorted, double percentile);
+
+        std::vector<Time> m_rtts;   //!< Measured RTTs, allocated for all expected replies beforehand
+        uint64_t m_requests;        //!< Number of echo requests sent until the probe is stopped
+    };
+
+} // namespace ns3
+
+#endif /* LATENCY_PROBE_H */
@@ -0,0 +1,123 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// Kommunikation in verteilten Systemen - Memory report
+// mallinfo reports the bytes in use by the allocator: uordblks for the small chunks served from the arenas,
+// hblkhd for the large ones mapped separately. Its fields are ints, so it can not count beyond 2 GiB per field.
+// mallinfo2 fixes that and replaces it since glibc 2.33, where mallinfo is deprecated.
+
+#include <algorithm>
+#include "ns3/log.h"
+#include "ns3/node.h"
+#include "ns3/node-list.h"
+#include "ns3/net-device.h"
+#include "ns3/application.h"
+#include "memory-report.h"
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+
+namespace ns3 {
+
+    NS_LOG_COMPONENT_DEFINE ("MemoryReport");
+
+    MemoryReport::MemoryReport() {
+        m_baseline = GetAllocatedBytes();
+        m_last = m_baseline;
+    }
+
+    uint64_t
+    MemoryReport::GetAllocatedBytes(void) {
+#ifdef __GLIBC__
+#if __GLIBC_PREREQ(2, 33)
+        struct mallinfo2 info = mallinfo2();
+        return (uint64_t) info.uordblks + (uint64_t) info.hblkhd;
+#else
+        struct mallinfo info = mallinfo();
+        return (uint64_t) (unsigned int) info.uordblks + (uint64_t) (unsigned int) info.hblkhd;
+#endif
+#else
+        return 0;
+#endif
+    }
+
+    void
+    MemoryReport::Mark(std::string phase) {
+        uint64_t allocated = GetAllocatedBytes();
+
+        Phase entry;
+        entry.name = phase;
+        entry.bytes = (int64_t) allocated - (int64_t) m_last;
+        entry.nodes = NodeList::GetNNodes();
+        entry.devices = 0;
+        entry.applications = 0;
+        entry.objects = 0;
+        for (NodeList::Iterator i = NodeList::Begin(); i != NodeList::End(); ++i) {
+            entry.devices += (*i)->GetNDevices();
+            entry.applications += (*i)->GetNApplications();
+            for (uint32_t d = 0; d < (*i)->GetNDevices(); ++d) {
+                entry.types[(*i)->GetDevice(d)->GetInstanceTypeId().GetName()]++;
+            }
+            for (uint32_t a = 0; a < (*i)->GetNApplications(); ++a) {
+                entry.types[(*i)->GetApplication(a)->GetInstanceTypeId().GetName()]++;
+            }
+            // The node itself is one of its aggregates
+            Object::AggregateIterator aggregates = (*i)->GetAggregateIterator();
+            while (aggregates.HasNext()) {
+                entry.types[aggregates.Next()->GetInstanceTypeId().GetName()]++;
+                entry.objects++;
+            }
+        }
+        m_phases.push_back(entry);
+        m_last = allocated;
+    }
+
+    void
+    MemoryReport::PrintJson(std::ostream &os) const {
+        uint32_t nodes = 0;
+        os << "{\"phases\":[";
+        for (std::vector<Phase>::const_iterator i = m_phases.begin(); i != m_phases.end(); ++i) {
+            nodes = std::max(nodes, i->nodes);
+            if (i != m_phases.begin()) {
+                os << ",";
+            }
+            os << "{";
+            os << "\"phase\":\"" << i->name << "\",";
+            os << "\"bytes\":" << i->bytes << ",";
+            os << "\"bytes_per_node\":" << (i->nodes > 0 ? i->bytes / (int64_t) i->nodes : 0) << ",";
+            os << "\"nodes\":" << i->nodes << ",";
+            os << "\"net_devices\":" << i->devices << ",";
+            os << "\"applications\":" << i->applications << ",";
+            os << "\"aggregated_objects\":" << i->objects << ",";
+            os << "\"types\":{";
+            for (std::map<std::string, uint32_t>::const_iterator t = i->types.begin(); t != i->types.end(); ++t) {
+                if (t != i->types.begin()) {
+                    os << ",";
+                }
+                os << "\"" << t->first << "\":" << t->second;
+            }
+            os << "}";
+            os << "}";
+        }
+        os << "],";
+
+        int64_t total = (int64_t) m_last - (int64_t) m_baseline;
+        os << "\"total_bytes\":" << total << ",";
+        os << "\"bytes_per_node\":" << (nodes > 0 ? total / (int64_t) nodes : 0);
+        os << "}";
+    }
+
+} // namespace ns3
@@ -0,0 +1,85 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MEMORY_REPORT_H
+#define MEMORY_REPORT_H
+
+#include <map>
+#include <ostream>
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+namespace ns3 {
+
+/**
+ * \brief Heap memory allocated by the phases of building and running a simulation.
+ *
+ * Every Mark records the bytes allocated from the heap since the previous one (using
+ * glibc's mallinfo2 or mallinfo, 0 elsewhere) and counts the nodes, net devices,
+ * applications and objects aggregated to the nodes existing at that time, per TypeId
+ * (e.g. ns3::WifiNetDevice, ns3::olsr::RoutingProtocol, ns3::Ipv4L3Protocol).
+ *
+ * The allocator can not tell which object a byte belongs to, so the bytes are only
+ * broken down by phase: marking a phase right after the component it creates (e.g.
+ * the wifi devices, the internet stack) was installed stands in for a breakdown by
+ * component. Objects owned by another object without being aggregated (e.g. the
+ * MAC queues of a WifiNetDevice, trace sinks) are part of the bytes of the phase,
+ * but not of the counts.
+ */
+    class MemoryReport {
+    public:
+        MemoryReport();
+
+        /**
+         * Account the memory allocated since the previous mark (or the construction) to a phase.
+         *
+         * \param phase the name of the phase
+         */
+        void Mark(std::string phase);
+
+        /**
+         * Print the phases as JSON object.
+         *
+         * \param os the stream to print to
+         */
+        void PrintJson(std::ostream &os) const;
+
+    private:
+        /// Memory and objects of one phase
+        struct Phase {
+            std::string name;       //!< Name of the phase
+            int64_t bytes;          //!< Bytes allocated during the phase (negative if freed)
+            uint32_t nodes;         //!< Nodes at the end of the phase
+            uint32_t devices;       //!< Net devices at the end of the phase
+            uint32_t applications;  //!< Applications at the end of the phase
+            uint32_t objects;       //!< Objects aggregated to the nodes at the end of the phase
+            std::map<std::string, uint32_t> types;  //!< Aggregates, devices and applications per TypeId
+        };
+
+        /**
+         * \return the bytes currently allocated from the heap
+         */
+        static uint64_t GetAllocatedBytes(void);
+
+        std::vector<Phase> m_phases;    //!< The phases marked so far
+        uint64_t m_baseline;            //!< Bytes allocated at construction
+        uint64_t m_last;                //!< Bytes allocated at the previous mark
+    };
+
+} // namespace ns3
+
+#endif /* MEMORY_REPORT_H */
@@ -0,0 +1,135 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// Kommunikation in verteilten Systemen - Point-to-point link accounting
+// Like the airtime accounting, the trace sinks are bound to the counters of the device directly.
+// Whether a link is the bottleneck shows in its utilisation and in the occupancy of its device queue.
+
+#include <algorithm>
+#include "ns3/log.h"
+#include "ns3/callback.h"
+#include "ns3/node.h"
+#include "ns3/simulator.h"
+#include "ns3/queue.h"
+#include "ns3/point-to-point-net-device.h"
+#include "p2p-link-stats.h"
+
+namespace ns3 {
+
+    NS_LOG_COMPONENT_DEFINE ("PointToPointLinkStats");
+
+    PointToPointLinkStats::PointToPointLinkStats() {
+        m_window.start = Seconds(0);
+        m_window.end = Time::Max();
+    }
+
+    void
+    PointToPointLinkStats::Install(NetDeviceContainer link) {
+        NS_ASSERT_MSG (link.GetN() == 2, "A point-to-point link has exactly two devices");
+
+        for (uint32_t i = 0; i < 2; ++i) {
+            Ptr<PointToPointNetDevice> device = DynamicCast<PointToPointNetDevice>(link.Get(i));
+            NS_ASSERT_MSG (device, "PointToPointLinkStats can only be installed on PointToPointNetDevices");
+
+            Direction direction;
+            direction.window = &m_window;
+            direction.from = device->GetNode()->GetId();
+            direction.to = link.Get(1 - i)->GetNode()->GetId();
+            DataRateValue rate;
+            device->GetAttribute("DataRate", rate);
+            direction.rate = rate.Get();
+            direction.txPackets = 0;
+            direction.txBytes = 0;
+            direction.drops = 0;
+            direction.maxQueuePackets = 0;
+            m_directions.push_back(direction);
+
+            Direction *counters = &m_directions.back();
+            device->TraceConnectWithoutContext("PhyTxBegin", MakeBoundCallback(&PointToPointLinkStats::PhyTxBegin, counters));
+            device->TraceConnectWithoutContext("MacTxDrop", MakeBoundCallback(&PointToPointLinkStats::Drop, counters));
+            device->TraceConnectWithoutContext("PhyTxDrop", MakeBoundCallback(&PointToPointLinkStats::Drop, counters));
+            device->GetQueue()->TraceConnectWithoutContext(
+                    "PacketsInQueue", MakeBoundCallback(&PointToPointLinkStats::QueueChanged, counters));
+        }
+    }
+
+    void
+    PointToPointLinkStats::SetWindowStart(Time start) {
+        m_window.start = start;
+    }
+
+    void
+    PointToPointLinkStats::SetWindowEnd(Time end) {
+        m_window.end = end;
+    }
+
+    bool
+    PointToPointLinkStats::InWindow(const Direction *direction) {
+        Time now = Simulator::Now();
+        return now >= direction->window->start && now < direction->window->end;
+    }
+
+    void
+    PointToPointLinkStats::PhyTxBegin(Direction *direction, Ptr<const Packet> packet) {
+        if (InWindow(direction)) {
+            direction->txPackets++;
+            direction->txBytes += packet->GetSize();
+        }
+    }
+
+    void
+    PointToPointLinkStats::Drop(Direction *direction, Ptr<const Packet> packet) {
+        if (InWindow(direction)) {
+            direction->drops++;
+        }
+    }
+
+    void
+    PointToPointLinkStats::QueueChanged(Direction *direction, uint32_t oldValue, uint32_t newValue) {
+        if (InWindow(direction)) {
+            direction->maxQueuePackets = std::max(direction->maxQueuePackets, newValue);
+        }
+    }
+
+    void
+    PointToPointLinkStats::PrintJson(std::ostream &os, Time end) const {
+        end = std::min(end, m_window.end);
+        Time length = std::max(end - m_window.start, Seconds(0));
+        double window = length.IsStrictlyPositive() ? length.GetSeconds() : 1.0;
+
+        os << "[";
+        for (std::deque<Direction>::const_iterator i = m_directions.begin(); i != m_directions.end(); ++i) {
+            // Not DataRate::CalculateBytesTxTime, it takes the bytes as uint32_t and wraps after 4 GiB
+            double busy = i->rate.GetBitRate() > 0 ? i->txBytes * 8.0 / i->rate.GetBitRate() : 0.0;
+
+            if (i != m_directions.begin()) {
+                os << ",";
+            }
+            os << "{";
+            os << "\"from\":" << i->from << ",";
+            os << "\"to\":" << i->to << ",";
+            os << "\"rate_bps\":" << i->rate.GetBitRate() << ",";
+            os << "\"tx_packets\":" << i->txPackets << ",";
+            os << "\"tx_bytes\":" << i->txBytes << ",";
+            os << "\"drops\":" << i->drops << ",";
+            os << "\"max_queue_packets\":" << i->maxQueuePackets << ",";
+            os << "\"utilisation\":" << std::min(1.0, busy / window);
+            os << "}";
+        }
+        os << "]";
+    }
+
+} // namespace ns3
@@ -0,0 +1,127 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef P2P_LINK_STATS_H
+#define P2P_LINK_STATS_H
+
+#include <deque>
+#include <ostream>
+#include "ns3/nstime.h"
+#include "ns3/data-rate.h"
+#include "ns3/packet.h"
+#include "ns3/net-device-container.h"
+
+namespace ns3 {
+
+/**
+ * \brief Per-direction load accounting of point-to-point links.
+ *
+ * For every direction of a link the packets and bytes put on the wire inside the
+ * measurement window, the packets dropped by the device and the maximum occupancy
+ * of the device queue are recorded. The utilisation is the time needed to
+ * serialise the transmitted bytes at the link's data rate, relative to the window.
+ */
+    class PointToPointLinkStats {
+    public:
+        PointToPointLinkStats();
+
+        /**
+         * Connect to the traces of both devices of a point-to-point link. Can be called
+         * for any number of links, but only before the simulation is started.
+         *
+         * \param link the two PointToPointNetDevices of the link
+         */
+        void Install(NetDeviceContainer link);
+
+        /**
+         * Set the beginning of the measurement window (default: 0s).
+         *
+         * \param start the beginning of the measurement window
+         */
+        void SetWindowStart(Time start);
+
+        /**
+         * Close the measurement window. Can be called while the simulation is running.
+         *
+         * \param end the end of the measurement window
+         */
+        void SetWindowEnd(Time end);
+
+        /**
+         * Print the statistics of every link direction as JSON array.
+         *
+         * \param os the stream to print to
+         * \param end the time the simulation stopped; used if the window was not closed before
+         */
+        void PrintJson(std::ostream &os, Time end) const;
+
+    private:
+        /// The measurement window shared by all links
+        struct Window {
+            Time start;     //!< Beginning of the measurement window
+            Time end;       //!< End of the measurement window
+        };
+
+        /// Counters of one direction of a link
+        struct Direction {
+            const Window *window;       //!< The measurement window
+            uint32_t from;              //!< Node transmitting in this direction
+            uint32_t to;                //!< Node receiving in this direction
+            DataRate rate;              //!< Data rate of the transmitting device
+            uint64_t txPackets;         //!< Packets put on the wire
+            uint64_t txBytes;           //!< Bytes put on the wire
+            uint64_t drops;             //!< Packets dropped by the device (queue full or link down)
+            uint32_t maxQueuePackets;   //!< Maximum number of packets inside the device queue
+        };
+
+        /**
+         * Trace sink for the PointToPointNetDevice "PhyTxBegin" trace source.
+         *
+         * \param direction the counters of the transmitting device
+         * \param packet the packet put on the wire
+         */
+        static void PhyTxBegin(Direction *direction, Ptr<const Packet> packet);
+
+        /**
+         * Trace sink for the PointToPointNetDevice "MacTxDrop" and "PhyTxDrop" trace sources.
+         *
+         * \param direction the counters of the transmitting device
+         * \param packet the dropped packet
+         */
+        static void Drop(Direction *direction, Ptr<const Packet> packet);
+
+        /**
+         * Trace sink for the "PacketsInQueue" trace source of the device queue.
+         *
+         * \param direction the counters of the transmitting device
+         * \param oldValue the previous number of packets inside the queue
+         * \param newValue the current number of packets inside the queue
+         */
+        static void QueueChanged(Direction *direction, uint32_t oldValue, uint32_t newValue);
+
+        /**
+         * \param direction the counters of the transmitting device
+         * \return true if the current time lies inside the measurement window
+         */
+        static bool InWindow(const Direction *direction);
+
+        std::deque<Direction> m_directions; //!< Counters, two per link; a deque keeps them in place while growing
+        Window m_window;                    //!< The measurement window
+    };
+
+} // namespace ns3
+
+#endif /* P2P_LINK_STATS_H */
@@ -0,0 +1,239 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// Kommunikation in verteilten Systemen - Point-to-point topology
+// A single link only ever shows the bottleneck of one hop. Chains and trees of links with
+// different rates and delays show where the bottleneck moves and how the queues in front
+// of it fill up. Every link gets its own PointToPointHelper, as the helper holds only one
+// data rate, delay and queue size.
+
+#include <fstream>
+#include <sstream>
+#include "ns3/log.h"
+#include "ns3/string.h"
+#include "ns3/point-to-point-helper.h"
+#include "p2p-topology-helper.h"
+
+namespace ns3 {
+
+    NS_LOG_COMPONENT_DEFINE ("PointToPointTopologyHelper");
+
+    PointToPointTopologyHelper::PointToPointTopologyHelper() {
+        SetChain(1);
+        SetLinkAttributes("100Mbps", "5ms", "");
+    }
+
+    void
+    PointToPointTopologyHelper::SetChain(uint32_t hops) {
+        if (hops == 0) {
+            NS_FATAL_ERROR("A chain needs at least one hop");
+        }
+        m_type = "chain";
+        m_depth = hops;
+        m_fanout = 1;
+        m_nodes = hops + 1;
+
+        m_links.resize(hops);
+        for (uint32_t i = 0; i < hops; ++i) {
+            m_links[i].from = i;
+            m_links[i].to = i + 1;
+        }
+    }
+
+    void
+    PointToPointTopologyHelper::SetTree(uint32_t depth, uint32_t fanout) {
+        if (depth == 0 || fanout == 0) {
+            NS_FATAL_ERROR("A tree needs a depth and a fanout of at least one");
+        }
+        m_type = "tree";
+        m_depth = depth;
+        m_fanout = fanout;
+
+        // 1 + f + f^2 + ... + f^depth nodes
+        uint32_t level = 1;
+        m_nodes = 1;
+        for (uint32_t i = 0; i < depth; ++i) {
+            level *= fanout;
+            m_nodes += level;
+        }
+
+        // Nodes are numbered breadth first, so the parent of node j is (j - 1) / fanout
+        m_links.resize(m_nodes - 1);
+        for (uint32_t j = 1; j < m_nodes; ++j) {
+            m_links[j - 1].from = j;
+            m_links[j - 1].to = (j - 1) / fanout;
+        }
+    }
+
+    void
+    PointToPointTopologyHelper::SetLinkAttributes(std::string rates, std::string delays, std::string queues) {
+        std::vector<std::string> rateList = Split(rates);
+        std::vector<std::string> delayList = Split(delays);
+        std::vector<std::string> queueList = Split(queues);
+        if (rateList.empty() || delayList.empty()) {
+            NS_FATAL_ERROR("Every link needs a data rate and a delay");
+        }
+
+        for (uint32_t i = 0; i < m_links.size(); ++i) {
+            m_links[i].rate = Pick(rateList, i);
+            m_links[i].delay = Pick(delayList, i);
+            m_links[i].queue = Pick(queueList, i);
+        }
+    }
+
+    void
+    PointToPointTopologyHelper::ReadLinkFile(std::string file) {
+        std::ifstream in(file.c_str());
+        if (!in) {
+            NS_FATAL_ERROR("Cannot open link file " << file);
+        }
+
+        std::string line;
+        uint32_t lineNumber = 0;
+        uint32_t link = 0;
+        while (std::getline(in, line)) {
+            ++lineNumber;
+            std::string::size_type comment = line.find('#');
+            if (comment != std::string::npos) {
+                line.erase(comment);
+            }
+
+            std::istringstream fields(line);
+            std::string rate, delay, queue, rest;
+            if (!(fields >> rate)) {
+                continue;   // Empty line
+            }
+            if (!(fields >> delay) || (fields >> queue && fields >> rest)) {
+                NS_FATAL_ERROR(file << ":" << lineNumber << ": expected \"<rate> <delay> [<queue>]\"");
+            }
+            if (link >= m_links.size()) {
+                NS_FATAL_ERROR(file << ":" << lineNumber << ": the topology only has " << m_links.size() << " links");
+            }
+
+            if (rate != "-") {
+                m_links[link].rate = rate;
+            }
+            if (delay != "-") {
+                m_links[link].delay = delay;
+            }
+            if (!queue.empty() && queue != "-") {
+                m_links[link].queue = queue;
+            }
+            ++link;
+        }
+    }
+
+    NodeContainer
+    PointToPointTopologyHelper::Install(void) {
+        NS_ASSERT_MSG (m_devices.empty(), "PointToPointTopologyHelper::Install must only be called once");
+
+        NodeContainer nodes;
+        nodes.Create(m_nodes);
+
+        for (std::vector<Link>::const_iterator i = m_links.begin(); i != m_links.end(); ++i) {
+            PointToPointHelper pointToPoint;
+            pointToPoint.SetDeviceAttribute("DataRate", StringValue(i->rate));
+            pointToPoint.SetChannelAttribute("Delay", StringValue(i->delay));
+            if (!i->queue.empty()) {
+                pointToPoint.SetQueue("ns3::DropTailQueue", "MaxSize", StringValue(i->queue));
+            }
+            m_devices.push_back(pointToPoint.Install(nodes.Get(i->from), nodes.Get(i->to)));
+            NS_LOG_INFO("Link " << i->from << " - " << i->to << ": " << i->rate << ", " << i->delay);
+        }
+        return nodes;
+    }
+
+    const std::vector<NetDeviceContainer> &
+    PointToPointTopologyHelper::GetLinks(void) const {
+        return m_devices;
+    }
+
+    NetDeviceContainer
+    PointToPointTopologyHelper::GetDevices(void) const {
+        NetDeviceContainer devices;
+        for (std::vector<NetDeviceContainer>::const_iterator i = m_devices.begin(); i != m_devices.end(); ++i) {
+            devices.Add(*i);
+        }
+        return devices;
+    }
+
+    std::vector<uint32_t>
+    PointToPointTopologyHelper::GetSources(void) const {
+        std::vector<uint32_t> sources;
+        if (m_type == "chain") {
+            sources.push_back(0);
+        } else {
+            // The leaves are the last fanout^depth nodes
+            uint32_t leaves = 1;
+            for (uint32_t i = 0; i < m_depth; ++i) {
+                leaves *= m_fanout;
+            }
+            for (uint32_t j = m_nodes - leaves; j < m_nodes; ++j) {
+                sources.push_back(j);
+            }
+        }
+        return sources;
+    }
+
+    uint32_t
+    PointToPointTopologyHelper::GetSink(void) const {
+        return m_type == "chain" ? m_nodes - 1 : 0;
+    }
+
+    void
+    PointToPointTopologyHelper::PrintJson(std::ostream &os) const {
+        os << "{";
+        os << "\"type\":\"" << m_type << "\",";
+        os << "\"depth\":" << m_depth << ",";
+        os << "\"fanout\":" << m_fanout << ",";
+        os << "\"nodes\":" << m_nodes << ",";
+        os << "\"sink\":" << GetSink() << ",";
+        os << "\"links\":[";
+        for (std::vector<Link>::const_iterator i = m_links.begin(); i != m_links.end(); ++i) {
+            if (i != m_links.begin()) {
+                os << ",";
+            }
+            os << "{";
+            os << "\"from\":" << i->from << ",";
+            os << "\"to\":" << i->to << ",";
+            os << "\"rate\":\"" << i->rate << "\",";
+            os << "\"delay\":\"" << i->delay << "\",";
+            os << "\"queue\":\"" << i->queue << "\"";
+            os << "}";
+        }
+        os << "]}";
+    }
+
+    std::vector<std::string>
+    PointToPointTopologyHelper::Split(std::string list) {
+        std::vector<std::string> values;
+        std::istringstream in(list);
+        std::string value;
+        while (std::getline(in, value, ',')) {
+            values.push_back(value);
+        }
+        return values;
+    }
+
+    std::string
+    PointToPointTopologyHelper::Pick(const std::vector<std::string> &values, uint32_t index) {
+        if (values.empty()) {
+            return "";
+        }
+        return index < values.size() ? values[index] : values.back();
+    }
+
+} // namespace ns3
@@ -0,0 +1,145 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef P2P_TOPOLOGY_HELPER_H
+#define P2P_TOPOLOGY_HELPER_H
+
+#include <ostream>
+#include <string>
+#include <vector>
+#include "ns3/node-container.h"
+#include "ns3/net-device-container.h"
+
+namespace ns3 {
+
+/**
+ * \brief Build a chain or a tree of point-to-point links with per-link parameters.
+ *
+ * Chain: nodes 0 .. n are connected in a line, link i connects node i and
+ * node i + 1. Node 0 is the only source, node n the sink.
+ *
+ * Tree: node 0 is the root and the sink, every node has fanout children up to
+ * the given depth (nodes numbered breadth first). Link i connects node i + 1
+ * to its parent. Every leaf is a source.
+ *
+ * Data rate, delay and device queue size can be set for every link. They are
+ * given as comma separated lists, where the last value also applies to all
+ * further links, and can be overridden per link by a file with one line per
+ * link: "<rate> <delay> [<queue>]", where "-" keeps the value of the lists.
+ */
+    class PointToPointTopologyHelper {
+    public:
+        PointToPointTopologyHelper();
+
+        /**
+         * Build a chain.
+         *
+         * \param hops the number of links between source and sink
+         */
+        void SetChain(uint32_t hops);
+
+        /**
+         * Build a tree.
+         *
+         * \param depth the number of links between the leaves and the root
+         * \param fanout the number of children of every inner node
+         */
+        void SetTree(uint32_t depth, uint32_t fanout);
+
+        /**
+         * Set the parameters of the links.
+         *
+         * \param rates comma separated data rates, e.g. "100Mbps,10Mbps"
+         * \param delays comma separated delays, e.g. "5ms"
+         * \param queues comma separated device queue sizes, e.g. "100p" (empty: ns3's default)
+         */
+        void SetLinkAttributes(std::string rates, std::string delays, std::string queues);
+
+        /**
+         * Override the parameters of the links by a file (see class description).
+         *
+         * \param file the name of the file
+         */
+        void ReadLinkFile(std::string file);
+
+        /**
+         * Create the nodes and install the links between them.
+         *
+         * \return the nodes, node i of the description is the i-th node in the container
+         */
+        NodeContainer Install(void);
+
+        /**
+         * \return the two devices of every link, in the order of the links
+         */
+        const std::vector<NetDeviceContainer> &GetLinks(void) const;
+
+        /**
+         * \return the devices of all links
+         */
+        NetDeviceContainer GetDevices(void) const;
+
+        /**
+         * \return the indices of the nodes running a source
+         */
+        std::vector<uint32_t> GetSources(void) const;
+
+        /**
+         * \return the index of the node running the sink
+         */
+        uint32_t GetSink(void) const;
+
+        /**
+         * Print the topology and the parameters of every link as JSON object.
+         *
+         * \param os the stream to print to
+         */
+        void PrintJson(std::ostream &os) const;
+
+    private:
+        /// Parameters of one link
+        struct Link {
+            uint32_t from;          //!< Node farther away from the sink
+            uint32_t to;            //!< Node closer to the sink
+            std::string rate;       //!< Data rate of both devices
+            std::string delay;      //!< Delay of the channel
+            std::string queue;      //!< Size of both device queues (empty: ns3's default)
+        };
+
+        /**
+         * \param list comma separated values
+         * \return the values
+         */
+        static std::vector<std::string> Split(std::string list);
+
+        /**
+         * \param values the values of a list
+         * \param index the index of the link
+         * \return the value for the link, the last value of the list if it is shorter
+         */
+        static std::string Pick(const std::vector<std::string> &values, uint32_t index);
+
+        std::string m_type;                 //!< chain or tree
+        uint32_t m_depth;                   //!< Hops of the chain, depth of the tree
+        uint32_t m_fanout;                  //!< Children of every inner node (1 for the chain)
+        uint32_t m_nodes;                   //!< Number of nodes
+        std::vector<Link> m_links;          //!< The links
+        std::vector<NetDeviceContainer> m_devices;  //!< Devices of the installed links
+    };
+
+} // namespace ns3
+
+#endif /* P2P_TOPOLOGY_HELPER_H */
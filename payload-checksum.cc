@@ -0,0 +1,47 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// Kommunikation in verteilten Systemen - Payload checksum
+// FNV-1a is not a cryptographic hash, but any reordered, lost, duplicated or corrupted byte changes it,
+// which is all the integrity check of a simulated transfer needs. It is cheap and needs no tables.
+
+#include "payload-checksum.h"
+
+namespace ns3 {
+
+    static const uint64_t FNV_OFFSET_BASIS = 14695981039346656037ULL;
+    static const uint64_t FNV_PRIME = 1099511628211ULL;
+
+    PayloadChecksum::PayloadChecksum()
+            : m_hash(FNV_OFFSET_BASIS) {
+    }
+
+    void
+    PayloadChecksum::Update(const uint8_t *data, uint64_t size) {
+        uint64_t hash = m_hash;
+        for (const uint8_t *end = data + size; data != end; ++data) {
+            hash ^= *data;
+            hash *= FNV_PRIME;
+        }
+        m_hash = hash;
+    }
+
+    uint64_t
+    PayloadChecksum::Get(void) const {
+        return m_hash;
+    }
+
+} // namespace ns3
@@ -0,0 +1,54 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef PAYLOAD_CHECKSUM_H
+#define PAYLOAD_CHECKSUM_H
+
+#include <stdint.h>
+
+namespace ns3 {
+
+/**
+ * \brief Running 64 bit FNV-1a checksum of a byte stream.
+ *
+ * The checksum only depends on the sequence of bytes, not on how they are
+ * split into calls of Update, so a sender can checksum a file at once and a
+ * receiver the same bytes segment by segment as they arrive.
+ */
+    class PayloadChecksum {
+    public:
+        PayloadChecksum();
+
+        /**
+         * Add the next bytes of the stream.
+         *
+         * \param data the bytes
+         * \param size the number of bytes
+         */
+        void Update(const uint8_t *data, uint64_t size);
+
+        /**
+         * \return the checksum of all bytes added so far
+         */
+        uint64_t Get(void) const;
+
+    private:
+        uint64_t m_hash;    //!< The checksum so far
+    };
+
+} // namespace ns3
+
+#endif /* PAYLOAD_CHECKSUM_H */
@@ -0,0 +1,227 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// Kommunikation in verteilten Systemen - Event profiling
+// Only the type_index of an event is looked up while the simulation runs, the type names are demangled when the
+// report is printed. The profiling scheduler is only installed if profiling was requested, so there is no overhead
+// otherwise.
+
+#include <algorithm>
+#include <cstdlib>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <cxxabi.h>
+#include "ns3/log.h"
+#include "ns3/pointer.h"
+#include "ns3/object-factory.h"
+#include "ns3/type-id.h"
+#include "ns3/event-impl.h"
+#include "ns3/map-scheduler.h"
+#include "profiling-scheduler.h"
+
+namespace ns3 {
+
+    NS_LOG_COMPONENT_DEFINE ("ProfilingScheduler");
+
+    NS_OBJECT_ENSURE_REGISTERED (SchedulerProfile);
+
+    NS_OBJECT_ENSURE_REGISTERED (ProfilingScheduler);
+
+    /**
+     * \param type the type to name
+     * \return the demangled name of the type
+     */
+    static std::string
+    GetTypeName(const std::type_index &type) {
+        int status = 0;
+        char *demangled = abi::__cxa_demangle(type.name(), 0, 0, &status);
+        if (status != 0 || !demangled) {
+            return type.name();
+        }
+        std::string name(demangled);
+        std::free(demangled);
+        return name;
+    }
+
+    TypeId
+    SchedulerProfile::GetTypeId(void) {
+        static TypeId tid = TypeId("ns3::SchedulerProfile")
+                .SetParent<Object>()
+                .AddConstructor<SchedulerProfile>();
+        return tid;
+    }
+
+    SchedulerProfile::SchedulerProfile()
+            : m_current(0),
+              m_finished(false) {
+    }
+
+    void
+    SchedulerProfile::Account(std::chrono::steady_clock::time_point now) {
+        if (!m_current) {
+            return;
+        }
+        std::unordered_map<std::type_index, Entry>::iterator i = m_entries.find(*m_current);
+        if (i == m_entries.end()) {
+            Entry entry = {std::type_index(*m_current), 0, 0.0};
+            i = m_entries.insert(std::make_pair(std::type_index(*m_current), entry)).first;
+        }
+        i->second.count++;
+        i->second.seconds += std::chrono::duration<double>(now - m_since).count();
+    }
+
+    void
+    SchedulerProfile::Next(EventImpl *event) {
+        if (m_finished) {
+            // Simulator::Destroy removes the remaining events without executing them
+            return;
+        }
+        std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+        Account(now);
+        // The event may be deleted after it ran, so only remember its type
+        m_current = &typeid(*event);
+        m_since = now;
+    }
+
+    void
+    SchedulerProfile::Finish(void) {
+        // Account the last event, there is no next one
+        Account(std::chrono::steady_clock::now());
+        m_current = 0;
+        m_finished = true;
+    }
+
+    std::vector<SchedulerProfile::Entry>
+    SchedulerProfile::GetTop(uint32_t top) const {
+        std::vector<Entry> entries;
+        entries.reserve(m_entries.size());
+        for (std::unordered_map<std::type_index, Entry>::const_iterator i = m_entries.begin(); i != m_entries.end(); ++i) {
+            entries.push_back(i->second);
+        }
+        std::sort(entries.begin(), entries.end(), [](const Entry &a, const Entry &b) {
+            return a.seconds > b.seconds;
+        });
+        if (entries.size() > top) {
+            entries.resize(top);
+        }
+        return entries;
+    }
+
+    void
+    SchedulerProfile::PrintReport(std::ostream &os, uint32_t top) const {
+        double total = 0.0;
+        uint64_t events = 0;
+        for (std::unordered_map<std::type_index, Entry>::const_iterator i = m_entries.begin(); i != m_entries.end(); ++i) {
+            total += i->second.seconds;
+            events += i->second.count;
+        }
+
+        os << "Event profile: " << events << " events, " << total * 1000.0 << "ms" << std::endl;
+        os << std::setw(10) << "ms" << std::setw(7) << "%" << std::setw(12) << "events" << std::setw(10) << "us/event"
+           << "  event type" << std::endl;
+        std::vector<Entry> entries = GetTop(top);
+        for (std::vector<Entry>::const_iterator i = entries.begin(); i != entries.end(); ++i) {
+            os << std::fixed << std::setprecision(1)
+               << std::setw(10) << i->seconds * 1000.0
+               << std::setw(7) << (total > 0.0 ? i->seconds / total * 100.0 : 0.0)
+               << std::setw(12) << i->count
+               << std::setprecision(3) << std::setw(10) << i->seconds * 1e6 / i->count
+               << "  " << GetTypeName(i->type) << std::endl;
+        }
+        os << std::defaultfloat;
+    }
+
+    void
+    SchedulerProfile::PrintJson(std::ostream &os, uint32_t top) const {
+        std::vector<Entry> entries = GetTop(top);
+        os << "[";
+        for (std::vector<Entry>::const_iterator i = entries.begin(); i != entries.end(); ++i) {
+            if (i != entries.begin()) {
+                os << ",";
+            }
+            os << "{";
+            os << "\"event\":\"" << GetTypeName(i->type) << "\",";
+            os << "\"count\":" << i->count << ",";
+            os << "\"wall_ms\":" << i->seconds * 1000.0;
+            os << "}";
+        }
+        os << "]";
+    }
+
+    TypeId
+    ProfilingScheduler::GetTypeId(void) {
+        static TypeId tid = TypeId("ns3::ProfilingScheduler")
+                .SetParent<Scheduler>()
+                .AddConstructor<ProfilingScheduler>()
+                .AddAttribute("Scheduler", "The type of the scheduler keeping the events.",
+                              TypeIdValue(MapScheduler::GetTypeId()),
+                              MakeTypeIdAccessor(&ProfilingScheduler::m_schedulerType),
+                              MakeTypeIdChecker())
+                .AddAttribute("Profile", "The profile to account the events to.",
+                              PointerValue(),
+                              MakePointerAccessor(&ProfilingScheduler::m_profile),
+                              MakePointerChecker<SchedulerProfile>());
+        return tid;
+    }
+
+    ProfilingScheduler::ProfilingScheduler() {
+        NS_LOG_FUNCTION (this);
+    }
+
+    ProfilingScheduler::~ProfilingScheduler() {
+        NS_LOG_FUNCTION (this);
+    }
+
+    void
+    ProfilingScheduler::NotifyConstructionCompleted(void) {
+        ObjectFactory factory;
+        factory.SetTypeId(m_schedulerType);
+        m_scheduler = factory.Create<Scheduler>();
+        if (!m_profile) {
+            m_profile = CreateObject<SchedulerProfile>();
+        }
+        Scheduler::NotifyConstructionCompleted();
+    }
+
+    void
+    ProfilingScheduler::Insert(const Event &ev) {
+        m_scheduler->Insert(ev);
+    }
+
+    bool
+    ProfilingScheduler::IsEmpty(void) const {
+        return m_scheduler->IsEmpty();
+    }
+
+    Scheduler::Event
+    ProfilingScheduler::PeekNext(void) const {
+        return m_scheduler->PeekNext();
+    }
+
+    Scheduler::Event
+    ProfilingScheduler::RemoveNext(void) {
+        Event ev = m_scheduler->RemoveNext();
+        m_profile->Next(ev.impl);
+        return ev;
+    }
+
+    void
+    ProfilingScheduler::Remove(const Event &ev) {
+        m_scheduler->Remove(ev);
+    }
+
+} // namespace ns3
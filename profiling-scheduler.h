@@ -0,0 +1,145 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef PROFILING_SCHEDULER_H
+#define PROFILING_SCHEDULER_H
+
+#include <chrono>
+#include <ostream>
+#include <typeindex>
+#include <typeinfo>
+#include <unordered_map>
+#include <vector>
+#include "ns3/object.h"
+#include "ns3/scheduler.h"
+
+namespace ns3 {
+
+/**
+ * \brief Wall clock time and invocations of the simulator events, by event type.
+ *
+ * The type of an event is the dynamic type of its EventImpl. For events created by
+ * Simulator::Schedule this is the MakeEvent instantiation, i.e. the type of the
+ * function pointer (for member functions: their class and signature) and the types
+ * of the bound arguments, not the function itself. All member functions of a class
+ * with the same signature share one row: e.g. the HELLO, TC, MID and HNA timers of
+ * olsr::RoutingProtocol (all void (RoutingProtocol::*)()) or the timeouts of MacLow.
+ */
+    class SchedulerProfile : public Object {
+    public:
+        /**
+         * \brief Get the type ID.
+         * \return the object TypeId
+         */
+        static TypeId GetTypeId(void);
+
+        SchedulerProfile();
+
+        /**
+         * Account the time since the previous call to the previous event and start timing the next one.
+         *
+         * \param event the event which is executed next
+         */
+        void Next(EventImpl *event);
+
+        /**
+         * Account the time since the previous call to Next to the last event and stop profiling.
+         * Must be called as soon as Simulator::Run returned.
+         */
+        void Finish(void);
+
+        /**
+         * Print the event types which took most of the time as table.
+         *
+         * \param os the stream to print to
+         * \param top the number of event types to print
+         */
+        void PrintReport(std::ostream &os, uint32_t top) const;
+
+        /**
+         * Print the event types which took most of the time as JSON array.
+         *
+         * \param os the stream to print to
+         * \param top the number of event types to print
+         */
+        void PrintJson(std::ostream &os, uint32_t top) const;
+
+    private:
+        /// Accounting of one event type
+        struct Entry {
+            std::type_index type;   //!< The type of the EventImpl
+            uint64_t count;         //!< Events executed
+            double seconds;         //!< Wall clock time spent
+        };
+
+        /**
+         * Account the time since m_since to the running event.
+         *
+         * \param now the current wall clock time
+         */
+        void Account(std::chrono::steady_clock::time_point now);
+
+        /**
+         * \param top the maximum number of entries
+         * \return the entries which took most of the time, sorted by time
+         */
+        std::vector<Entry> GetTop(uint32_t top) const;
+
+        std::unordered_map<std::type_index, Entry> m_entries;  //!< Accounting, by type of the EventImpl
+        const std::type_info *m_current;                        //!< Type of the running event, 0 if none
+        std::chrono::steady_clock::time_point m_since;          //!< Start of the running event
+        bool m_finished;                                        //!< True once Finish has been called
+    };
+
+/**
+ * \brief A scheduler which profiles the events it hands to the simulator.
+ *
+ * The events are kept in the scheduler given by the Scheduler attribute. The simulator
+ * removes an event from the scheduler right before executing it, so the time between two
+ * calls of RemoveNext is the time the first event took (plus the overhead of the simulator,
+ * which is spread evenly over all events).
+ */
+    class ProfilingScheduler : public Scheduler {
+    public:
+        /**
+         * \brief Get the type ID.
+         * \return the object TypeId
+         */
+        static TypeId GetTypeId(void);
+
+        ProfilingScheduler();
+
+        virtual ~ProfilingScheduler();
+
+        // Inherited
+        virtual void Insert(const Event &ev);
+        virtual bool IsEmpty(void) const;
+        virtual Event PeekNext(void) const;
+        virtual Event RemoveNext(void);
+        virtual void Remove(const Event &ev);
+
+    protected:
+        virtual void NotifyConstructionCompleted(void);
+
+    private:
+        TypeId m_schedulerType;         //!< Type of the scheduler keeping the events
+        Ptr<Scheduler> m_scheduler;     //!< The scheduler keeping the events
+        Ptr<SchedulerProfile> m_profile;    //!< The profile to account the events to
+    };
+
+} // namespace ns3
+
+#endif /* PROFILING_SCHEDULER_H */
@@ -0,0 +1,127 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// Kommunikation in verteilten Systemen - Queue disc accounting
+// A bulk TCP transfer fills every buffer on its path. How long the packets wait inside the queue disc
+// (sojourn time) is the queueing delay an AQM scheme like CoDel or PIE tries to keep low.
+
+#include <algorithm>
+#include "ns3/log.h"
+#include "ns3/callback.h"
+#include "ns3/node.h"
+#include "ns3/simulator.h"
+#include "ns3/traffic-control-layer.h"
+#include "queue-disc-stats.h"
+
+namespace ns3 {
+
+    NS_LOG_COMPONENT_DEFINE ("QueueDiscStats");
+
+    QueueDiscStats::QueueDiscStats() {
+        m_window.start = Seconds(0);
+        m_window.end = Time::Max();
+    }
+
+    void
+    QueueDiscStats::Install(NetDeviceContainer devices) {
+        for (uint32_t i = 0; i < devices.GetN(); ++i) {
+            Ptr<NetDevice> device = devices.Get(i);
+            Ptr<TrafficControlLayer> tc = device->GetNode()->GetObject<TrafficControlLayer>();
+            NS_ASSERT_MSG (tc, "QueueDiscStats needs the internet stack to be installed");
+            Ptr<QueueDisc> disc = tc->GetRootQueueDiscOnDevice(device);
+            if (!disc) {
+                continue;
+            }
+
+            DiscCounters counters;
+            counters.window = &m_window;
+            counters.nodeId = device->GetNode()->GetId();
+            counters.deviceIndex = device->GetIfIndex();
+            counters.dequeued = 0;
+            counters.drops = 0;
+            counters.maxPackets = 0;
+            m_discs.push_back(counters);
+
+            DiscCounters *discCounters = &m_discs.back();
+            disc->TraceConnectWithoutContext("Drop", MakeBoundCallback(&QueueDiscStats::Drop, discCounters));
+            disc->TraceConnectWithoutContext("SojournTime", MakeBoundCallback(&QueueDiscStats::Sojourn, discCounters));
+            disc->TraceConnectWithoutContext(
+                    "PacketsInQueue", MakeBoundCallback(&QueueDiscStats::PacketsChanged, discCounters));
+        }
+    }
+
+    void
+    QueueDiscStats::SetWindowStart(Time start) {
+        m_window.start = start;
+    }
+
+    void
+    QueueDiscStats::SetWindowEnd(Time end) {
+        m_window.end = end;
+    }
+
+    bool
+    QueueDiscStats::InWindow(const DiscCounters *counters) {
+        Time now = Simulator::Now();
+        return now >= counters->window->start && now < counters->window->end;
+    }
+
+    void
+    QueueDiscStats::Drop(DiscCounters *counters, Ptr<const QueueDiscItem> item) {
+        if (InWindow(counters)) {
+            counters->drops++;
+        }
+    }
+
+    void
+    QueueDiscStats::Sojourn(DiscCounters *counters, Time sojourn) {
+        if (InWindow(counters)) {
+            counters->dequeued++;
+            counters->sojournSum += sojourn;
+            counters->sojournMax = std::max(counters->sojournMax, sojourn);
+        }
+    }
+
+    void
+    QueueDiscStats::PacketsChanged(DiscCounters *counters, uint32_t oldValue, uint32_t newValue) {
+        if (InWindow(counters)) {
+            counters->maxPackets = std::max(counters->maxPackets, newValue);
+        }
+    }
+
+    void
+    QueueDiscStats::PrintJson(std::ostream &os) const {
+        os << "[";
+        for (std::deque<DiscCounters>::const_iterator i = m_discs.begin(); i != m_discs.end(); ++i) {
+            double average = i->dequeued > 0 ? i->sojournSum.GetSeconds() * 1000.0 / i->dequeued : 0.0;
+
+            if (i != m_discs.begin()) {
+                os << ",";
+            }
+            os << "{";
+            os << "\"node\":" << i->nodeId << ",";
+            os << "\"device\":" << i->deviceIndex << ",";
+            os << "\"dequeued\":" << i->dequeued << ",";
+            os << "\"drops\":" << i->drops << ",";
+            os << "\"max_packets\":" << i->maxPackets << ",";
+            os << "\"sojourn_avg_ms\":" << average << ",";
+            os << "\"sojourn_max_ms\":" << i->sojournMax.GetSeconds() * 1000.0;
+            os << "}";
+        }
+        os << "]";
+    }
+
+} // namespace ns3
@@ -0,0 +1,125 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef QUEUE_DISC_STATS_H
+#define QUEUE_DISC_STATS_H
+
+#include <deque>
+#include <ostream>
+#include "ns3/nstime.h"
+#include "ns3/net-device-container.h"
+#include "ns3/queue-disc.h"
+
+namespace ns3 {
+
+/**
+ * \brief Occupancy, drops and queueing delay of the root queue discs of a set of devices.
+ *
+ * The sojourn time reported by the queue disc is the time a packet spent inside
+ * the queue disc, i.e. the queueing delay added by the node (not counting the
+ * device queue below it).
+ */
+    class QueueDiscStats {
+    public:
+        QueueDiscStats();
+
+        /**
+         * Connect to the traces of the root queue disc of every device in the container.
+         * The queue discs must have been installed before. Can be called several times,
+         * but only before the simulation is started.
+         *
+         * \param devices the devices with a root queue disc
+         */
+        void Install(NetDeviceContainer devices);
+
+        /**
+         * Set the beginning of the measurement window (default: 0s).
+         *
+         * \param start the beginning of the measurement window
+         */
+        void SetWindowStart(Time start);
+
+        /**
+         * Close the measurement window. Can be called while the simulation is running.
+         *
+         * \param end the end of the measurement window
+         */
+        void SetWindowEnd(Time end);
+
+        /**
+         * Print the statistics of every queue disc as JSON array.
+         *
+         * \param os the stream to print to
+         */
+        void PrintJson(std::ostream &os) const;
+
+    private:
+        /// The measurement window shared by all queue discs
+        struct Window {
+            Time start;     //!< Beginning of the measurement window
+            Time end;       //!< End of the measurement window
+        };
+
+        /// Counters of one queue disc
+        struct DiscCounters {
+            const Window *window;       //!< The measurement window
+            uint32_t nodeId;            //!< Node the queue disc belongs to
+            uint32_t deviceIndex;       //!< Index of the device on the node
+            uint64_t dequeued;          //!< Packets which left the queue disc
+            uint64_t drops;             //!< Packets dropped by the queue disc
+            uint32_t maxPackets;        //!< Maximum number of packets inside the queue disc
+            Time sojournSum;            //!< Sum of the sojourn times of the dequeued packets
+            Time sojournMax;            //!< Maximum sojourn time
+        };
+
+        /**
+         * \param counters the counters of a queue disc
+         * \return true if the current time lies inside the measurement window
+         */
+        static bool InWindow(const DiscCounters *counters);
+
+        /**
+         * Trace sink for the QueueDisc "Drop" trace source.
+         *
+         * \param counters the counters of the queue disc
+         * \param item the dropped packet
+         */
+        static void Drop(DiscCounters *counters, Ptr<const QueueDiscItem> item);
+
+        /**
+         * Trace sink for the QueueDisc "SojournTime" trace source.
+         *
+         * \param counters the counters of the queue disc
+         * \param sojourn the time the dequeued packet spent inside the queue disc
+         */
+        static void Sojourn(DiscCounters *counters, Time sojourn);
+
+        /**
+         * Trace sink for the QueueDisc "PacketsInQueue" trace source.
+         *
+         * \param counters the counters of the queue disc
+         * \param oldValue the previous number of packets inside the queue disc
+         * \param newValue the current number of packets inside the queue disc
+         */
+        static void PacketsChanged(DiscCounters *counters, uint32_t oldValue, uint32_t newValue);
+
+        std::deque<DiscCounters> m_discs;   //!< Counters, one per queue disc; a deque keeps them in place while growing
+        Window m_window;                    //!< The measurement window
+    };
+
+} // namespace ns3
+
+#endif /* QUEUE_DISC_STATS_H */
@@ -0,0 +1,150 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+
+# Runs a fixed set of simulation1/2/3 configurations with fixed seeds and compares the results to
+# regression-baseline.json:
+#  - the simulated metrics (bytes, times, packet counts) have to match exactly, the simulation is deterministic
+#  - the executed events have to be within --event-tolerance, the wall clock time of the run within --wall-tolerance
+# Any drift is printed as a table and makes the script exit with 1.
+#
+# ./regression.py              compare against the baseline
+# ./regression.py --update     record a new baseline (after an intended change, on the reference machine)
+
+import argparse
+import json
+import os
+import subprocess
+import sys
+
+SEEDS = ['--RngSeed=1', '--RngRun=1']
+
+CONFIGURATIONS = (
+    ('sim1-tcp', ['simulation1', '--maxBytes=1000000']),
+    ('sim1-udp', ['simulation1', '--maxBytes=1000000', '--socket_factory=ns3::UdpSocketFactory']),
+    ('sim1-tcp-parallel', ['simulation1', '--maxBytes=1000000', '--connections=4']),
+    ('sim2-tcp-g', ['simulation2', '--maxBytes=1000000']),
+    ('sim2-tcp-n', ['simulation2', '--maxBytes=1000000', '--standard=n-5']),
+    ('sim3-static-3hops', ['simulation3', '--height=100', '--maxBytes=1000000', '--distance=25', '--nodes=4']),
+    ('sim3-olsr-3hops', ['simulation3', '--height=100', '--maxBytes=1000000', '--distance=25', '--nodes=4',
+                         '--routing=olsr']),
+    ('sim3-udp-3hops', ['simulation3', '--height=100', '--maxBytes=1000000', '--distance=25', '--nodes=4',
+                        '--socket_factory=ns3::UdpSocketFactory']),
+    ('sim3-hybrid', ['simulation3', '--height=100', '--maxBytes=1000000', '--distance=25', '--nodes=6',
+                     '--topology=hybrid', '--segments=2']),
+    ('sim3-request-response', ['simulation3', '--height=100', '--distance=25', '--nodes=3',
+                               '--workload=request_response', '--transactions=200']),
+)
+
+# Simulated results, compared exactly (if the simulation reports them)
+METRICS = ('rx_bytes_application', 'rx_ms_last', 'rx_ms_first', 'rx_count_packets', 'rx_bytes_packets',
+           'tx_count_packets', 'tx_bytes_packets', 'tx_ms_last')
+
+BASELINE = 'regression-baseline.json'
+
+
+def run(bindir, command, repetitions):
+    run_app = [os.path.join(bindir, command[0])] + command[1:] + SEEDS
+    best = None
+    for _ in range(repetitions):
+        proc = subprocess.run(run_app, stdout=subprocess.PIPE, stderr=subprocess.DEVNULL)
+        if proc.returncode != 0:
+            raise RuntimeError(f'{" ".join(run_app)} exited with {proc.returncode}')
+        result = json.loads(proc.stdout)
+        # The fastest run is the one least disturbed by the rest of the machine
+        if best is None or result['simulator']['wall_ms'] < best['simulator']['wall_ms']:
+            best = result
+    record = {
+        'command': command,
+        'metrics': {metric: best[metric] for metric in METRICS if metric in best},
+        'events': best['simulator']['events'],
+        'wall_ms': best['simulator']['wall_ms'],
+    }
+    if 'request_response' in best:
+        record['metrics']['completed'] = best['request_response']['completed']
+    return record
+
+
+def relative_change(baseline, current):
+    if baseline == 0:
+        return 0.0 if current == 0 else float('inf')
+    return (current - baseline) / baseline
+
+
+def compare(name, baseline, current, event_tolerance, wall_tolerance):
+    drift = []
+    if baseline is None:
+        drift.append((name, 'baseline', '-', 'missing', ''))
+        return drift
+    if baseline['command'] != current['command']:
+        drift.append((name, 'command', ' '.join(baseline['command']), ' '.join(current['command']), ''))
+        return drift
+    for metric in sorted(set(baseline['metrics']) | set(current['metrics'])):
+        expected = baseline['metrics'].get(metric)
+        actual = current['metrics'].get(metric)
+        if expected != actual:
+            drift.append((name, metric, expected, actual, ''))
+    change = relative_change(baseline['events'], current['events'])
+    if abs(change) > event_tolerance:
+        drift.append((name, 'events', baseline['events'], current['events'], f'{change:+.1%}'))
+    # Only getting slower is a regression
+    change = relative_change(baseline['wall_ms'], current['wall_ms'])
+    if change > wall_tolerance:
+        drift.append((name, 'wall_ms', baseline['wall_ms'], current['wall_ms'], f'{change:+.1%}'))
+    return drift
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Compare simulation results against a stored baseline.')
+    parser.add_argument('--bindir', default='.', help='Directory containing simulation1/2/3')
+    parser.add_argument('--baseline', default=BASELINE, help='Baseline file')
+    parser.add_argument('--update', action='store_true', help='Record a new baseline instead of comparing')
+    parser.add_argument('--repetitions', type=int, default=3, help='Runs per configuration, the fastest counts')
+    parser.add_argument('--event-tolerance', type=float, default=0.01, help='Allowed relative change of events')
+    parser.add_argument('--wall-tolerance', type=float, default=0.25, help='Allowed relative slowdown of wall time')
+    parser.add_argument('configurations', nargs='*', help='Only run these configurations')
+    args = parser.parse_args()
+
+    selected = [(name, command) for name, command in CONFIGURATIONS
+                if not args.configurations or name in args.configurations]
+
+    try:
+        with open(args.baseline, 'r') as fp:
+            baseline = json.load(fp)
+    except FileNotFoundError:
+        if not args.update:
+            print(f'No baseline {args.baseline}, record it with --update first', file=sys.stderr)
+            return 1
+        baseline = {'configurations': {}}
+
+    results = {}
+    for name, command in selected:
+        print(f'Run {name}: {" ".join(command)}', file=sys.stderr)
+        results[name] = run(args.bindir, command, args.repetitions)
+
+    if args.update:
+        baseline['configurations'].update(results)
+        with open(args.baseline, 'w') as fp:
+            json.dump(baseline, fp, indent=2, sort_keys=True)
+            fp.write('\n')
+        print(f'Recorded {len(results)} configurations in {args.baseline}')
+        return 0
+
+    drift = []
+    for name, _ in selected:
+        drift += compare(name, baseline['configurations'].get(name), results[name],
+                         args.event_tolerance, args.wall_tolerance)
+
+    if not drift:
+        print(f'{len(selected)} configurations match {args.baseline}')
+        return 0
+
+    print(f"{'configuration':>22} {'value':>20} {'baseline':>14} {'current':>14} {'change':>8}")
+    for name, metric, expected, actual, change in drift:
+        print(f'{name:>22} {metric:>20} {str(expected):>14} {str(actual):>14} {change:>8}')
+    if any(metric == 'baseline' for _, metric, _, _, _ in drift):
+        print('Configurations without a baseline can be recorded with --update')
+    return 1
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,342 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// Kommunikation in verteilten Systemen - Request/response workload
+// Much of the real traffic are small request/response exchanges instead of bulk transfers. The client keeps one
+// transaction outstanding per connection (closed loop), so the offered load adapts to the latency of the path.
+// The latency histogram is allocated when the application starts, recording a transaction does not allocate.
+
+#include <algorithm>
+#include "ns3/log.h"
+#include "ns3/address.h"
+#include "ns3/node.h"
+#include "ns3/nstime.h"
+#include "ns3/socket.h"
+#include "ns3/simulator.h"
+#include "ns3/packet.h"
+#include "ns3/pointer.h"
+#include "ns3/uinteger.h"
+#include "ns3/string.h"
+#include "ns3/inet-socket-address.h"
+#include "ns3/inet6-socket-address.h"
+#include "ns3/tcp-socket-factory.h"
+#include "request-response-client.h"
+
+namespace ns3 {
+
+    NS_LOG_COMPONENT_DEFINE ("RequestResponseClient");
+
+    NS_OBJECT_ENSURE_REGISTERED (RequestResponseClient);
+
+    TypeId
+    RequestResponseClient::GetTypeId(void) {
+        static TypeId tid = TypeId("ns3::RequestResponseClient")
+                .SetParent<Application>()
+                .SetGroupName("Applications")
+                .AddConstructor<RequestResponseClient>()
+                .AddAttribute("Remote", "The address of the server",
+                              AddressValue(),
+                              MakeAddressAccessor(&RequestResponseClient::m_peer),
+                              MakeAddressChecker())
+                .AddAttribute("Concurrency", "Number of connections, each with one outstanding transaction.",
+                              UintegerValue(1),
+                              MakeUintegerAccessor(&RequestResponseClient::m_concurrency),
+                              MakeUintegerChecker<uint32_t>(1))
+                .AddAttribute("RequestSize", "Size of the requests in bytes (including the 8 byte header).",
+                              StringValue("ns3::ConstantRandomVariable[Constant=100]"),
+                              MakePointerAccessor(&RequestResponseClient::m_requestSize),
+                              MakePointerChecker<RandomVariableStream>())
+                .AddAttribute("ResponseSize", "Size of the responses in bytes.",
+                              StringValue("ns3::ConstantRandomVariable[Constant=1000]"),
+                              MakePointerAccessor(&RequestResponseClient::m_responseSize),
+                              MakePointerChecker<RandomVariableStream>())
+                .AddAttribute("MaxTransactions",
+                              "The total number of transactions to start. The value zero means "
+                              "that there is no limit.",
+                              UintegerValue(0),
+                              MakeUintegerAccessor(&RequestResponseClient::m_maxTransactions),
+                              MakeUintegerChecker<uint64_t>())
+                .AddAttribute("HistogramResolution", "Width of a bucket of the latency histogram.",
+                              TimeValue(MicroSeconds(100)),
+                              MakeTimeAccessor(&RequestResponseClient::m_resolution),
+                              MakeTimeChecker(NanoSeconds(1)))
+                .AddAttribute("HistogramBuckets", "Number of buckets of the latency histogram.",
+                              UintegerValue(100000),
+                              MakeUintegerAccessor(&RequestResponseClient::m_buckets),
+                              MakeUintegerChecker<uint32_t>(1));
+        return tid;
+    }
+
+    RequestResponseClient::RequestResponseClient()
+            : m_concurrency(1),
+              m_maxTransactions(0),
+              m_buckets(0),
+              m_started(0),
+              m_completed(0),
+              m_deliveredBytes(0) {
+        NS_LOG_FUNCTION (this);
+    }
+
+    RequestResponseClient::~RequestResponseClient() {
+        NS_LOG_FUNCTION (this);
+    }
+
+    uint64_t
+    RequestResponseClient::GetTransactions(void) const {
+        return m_completed;
+    }
+
+    uint64_t
+    RequestResponseClient::GetDeliveredBytes(void) const {
+        return m_deliveredBytes;
+    }
+
+    void
+    RequestResponseClient::SetCompleteCallback(Callback<void, uint64_t> callback) {
+        m_completeCallback = callback;
+    }
+
+    void
+    RequestResponseClient::DoDispose(void) {
+        NS_LOG_FUNCTION (this);
+
+        m_connections.clear();
+        m_completeCallback = MakeNullCallback<void, uint64_t>();
+        // chain up
+        Application::DoDispose();
+    }
+
+// Application Methods
+    void RequestResponseClient::StartApplication(void) // Called at time specified by Start
+    {
+        NS_LOG_FUNCTION (this);
+
+        if (!m_connections.empty()) {
+            // Restarted: continue on the connections which are still open
+            for (std::vector<Connection>::iterator i = m_connections.begin(); i != m_connections.end(); ++i) {
+                if (i->connected && i->txPending == 0 && i->rxPending == 0) {
+                    SendRequest(*i);
+                }
+            }
+            return;
+        }
+
+        m_start = Simulator::Now();
+        m_histogram.assign(m_buckets + 1, 0);
+
+        // The sockets refer to the connections by pointer, so the vector must not be resized afterwards
+        m_connections.resize(m_concurrency);
+        for (std::vector<Connection>::iterator i = m_connections.begin(); i != m_connections.end(); ++i) {
+            i->connected = false;
+            i->headerPending = false;
+            i->txPending = 0;
+            i->rxPending = 0;
+            i->socket = Socket::CreateSocket(GetNode(), TcpSocketFactory::GetTypeId());
+
+            if (Inet6SocketAddress::IsMatchingType(m_peer)) {
+                if (i->socket->Bind6() == -1) {
+                    NS_FATAL_ERROR ("Failed to bind socket");
+                }
+            } else if (InetSocketAddress::IsMatchingType(m_peer)) {
+                if (i->socket->Bind() == -1) {
+                    NS_FATAL_ERROR ("Failed to bind socket");
+                }
+            }
+
+            i->socket->Connect(m_peer);
+            i->socket->SetConnectCallback(
+                    MakeCallback(&RequestResponseClient::ConnectionSucceeded, this),
+                    MakeCallback(&RequestResponseClient::ConnectionFailed, this));
+            i->socket->SetSendCallback(MakeCallback(&RequestResponseClient::DataSend, this));
+            i->socket->SetRecvCallback(MakeCallback(&RequestResponseClient::HandleRead, this));
+        }
+    }
+
+    void RequestResponseClient::StopApplication(void) // Called at time specified by Stop
+    {
+        NS_LOG_FUNCTION (this);
+
+        for (std::vector<Connection>::iterator i = m_connections.begin(); i != m_connections.end(); ++i) {
+            if (i->connected) {
+                i->socket->Close();
+                i->connected = false;
+            }
+        }
+    }
+
+// Private helpers
+
+    void RequestResponseClient::SendRequest(Connection &connection) {
+        NS_LOG_FUNCTION (this);
+
+        if (m_maxTransactions > 0 && m_started >= m_maxTransactions) {
+            connection.socket->Close();
+            connection.connected = false;
+            return;
+        }
+        m_started++;
+
+        connection.requestSize = std::max<uint32_t>(8, m_requestSize->GetInteger());
+        connection.responseSize = std::max<uint32_t>(1, m_responseSize->GetInteger());
+        connection.headerPending = true;
+        connection.txPending = connection.requestSize;
+        connection.rxPending = connection.responseSize;
+        connection.sent = Simulator::Now();
+        SendPending(connection);
+    }
+
+    void RequestResponseClient::SendPending(Connection &connection) {
+        NS_LOG_FUNCTION (this);
+
+        if (connection.headerPending) {
+            if (connection.socket->GetTxAvailable() < 8) {
+                return;
+            }
+            uint8_t header[8];
+            for (int i = 0; i < 4; ++i) {
+                header[i] = (uint8_t) (connection.requestSize >> (24 - 8 * i));
+                header[4 + i] = (uint8_t) (connection.responseSize >> (24 - 8 * i));
+            }
+            connection.socket->Send(Create<Packet>(header, 8));
+            connection.headerPending = false;
+            connection.txPending -= 8;
+        }
+
+        while (connection.txPending > 0) {
+            uint32_t toSend = std::min(connection.txPending, connection.socket->GetTxAvailable());
+            if (toSend == 0) {
+                // The send buffer is full, DataSend will call us again
+                break;
+            }
+            int actual = connection.socket->Send(Create<Packet>(toSend));
+            if (actual <= 0) {
+                break;
+            }
+            connection.txPending -= actual;
+        }
+    }
+
+    void RequestResponseClient::Record(Time latency) {
+        m_completed++;
+        m_lastCompletion = Simulator::Now();
+        m_latencySum += latency;
+        if (m_completed == 1 || latency < m_latencyMin) {
+            m_latencyMin = latency;
+        }
+        m_latencyMax = std::max(m_latencyMax, latency);
+
+        uint64_t bucket = latency.GetTimeStep() / m_resolution.GetTimeStep();
+        m_histogram[std::min<uint64_t>(bucket, m_buckets)]++;
+    }
+
+    RequestResponseClient::Connection *
+    RequestResponseClient::FindConnection(Ptr<Socket> socket) {
+        // There are only a handful of connections, a linear search is fine
+        for (std::vector<Connection>::iterator i = m_connections.begin(); i != m_connections.end(); ++i) {
+            if (i->socket == socket) {
+                return &*i;
+            }
+        }
+        return 0;
+    }
+
+    void RequestResponseClient::ConnectionSucceeded(Ptr<Socket> socket) {
+        NS_LOG_FUNCTION (this << socket);
+        Connection *connection = FindConnection(socket);
+        if (connection) {
+            connection->connected = true;
+            SendRequest(*connection);
+        }
+    }
+
+    void RequestResponseClient::ConnectionFailed(Ptr<Socket> socket) {
+        NS_LOG_FUNCTION (this << socket);
+        NS_LOG_LOGIC ("RequestResponseClient, Connection Failed");
+    }
+
+    void RequestResponseClient::DataSend(Ptr<Socket> socket, uint32_t) {
+        NS_LOG_FUNCTION (this);
+        Connection *connection = FindConnection(socket);
+        if (connection && connection->connected) {
+            SendPending(*connection);
+        }
+    }
+
+    void RequestResponseClient::HandleRead(Ptr<Socket> socket) {
+        NS_LOG_FUNCTION (this << socket);
+        Connection *connection = FindConnection(socket);
+        if (!connection) {
+            return;
+        }
+
+        Ptr<Packet> packet;
+        while ((packet = socket->Recv())) {
+            if (packet->GetSize() == 0) {
+                break;
+            }
+            connection->rxPending -= std::min(connection->rxPending, packet->GetSize());
+            if (connection->rxPending == 0 && connection->txPending == 0 && !connection->headerPending) {
+                m_deliveredBytes += connection->requestSize + connection->responseSize;
+                Record(Simulator::Now() - connection->sent);
+                if (m_completed == m_maxTransactions && !m_completeCallback.IsNull()) {
+                    m_completeCallback(m_deliveredBytes);
+                }
+                if (connection->connected) {
+                    SendRequest(*connection);
+                }
+            }
+        }
+    }
+
+    double
+    RequestResponseClient::GetPercentile(double percentile) const {
+        if (m_completed == 0) {
+            return 0.0;
+        }
+        uint64_t rank = std::max<uint64_t>(1, (uint64_t) (percentile / 100.0 * m_completed + 0.5));
+        uint64_t count = 0;
+        for (uint32_t i = 0; i < m_buckets; ++i) {
+            count += m_histogram[i];
+            if (count >= rank) {
+                return std::min(TimeStep(m_resolution.GetTimeStep() * (i + 1)), m_latencyMax).GetSeconds() * 1000.0;
+            }
+        }
+        // Inside the overflow bucket
+        return m_latencyMax.GetSeconds() * 1000.0;
+    }
+
+    void
+    RequestResponseClient::PrintJson(std::ostream &os) const {
+        Time duration = m_lastCompletion - m_start;
+
+        os << "{";
+        os << "\"concurrency\":" << m_concurrency << ",";
+        os << "\"started\":" << m_started << ",";
+        os << "\"completed\":" << m_completed << ",";
+        os << "\"delivered_bytes\":" << m_deliveredBytes << ",";
+        os << "\"tps\":" << (duration.IsStrictlyPositive() ? m_completed / duration.GetSeconds() : 0.0) << ",";
+        os << "\"latency_min_ms\":" << m_latencyMin.GetSeconds() * 1000.0 << ",";
+        os << "\"latency_avg_ms\":"
+           << (m_completed > 0 ? m_latencySum.GetSeconds() * 1000.0 / m_completed : 0.0) << ",";
+        os << "\"latency_p50_ms\":" << GetPercentile(50.0) << ",";
+        os << "\"latency_p95_ms\":" << GetPercentile(95.0) << ",";
+        os << "\"latency_p99_ms\":" << GetPercentile(99.0) << ",";
+        os << "\"latency_max_ms\":" << m_latencyMax.GetSeconds() * 1000.0 << ",";
+        os << "\"histogram_overflows\":" << (m_histogram.empty() ? 0 : m_histogram.back());
+        os << "}";
+    }
+
+} // Namespace ns3
@@ -0,0 +1,178 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef REQUEST_RESPONSE_CLIENT_H
+#define REQUEST_RESPONSE_CLIENT_H
+
+#include <ostream>
+#include <vector>
+#include "ns3/address.h"
+#include "ns3/callback.h"
+#include "ns3/application.h"
+#include "ns3/nstime.h"
+#include "ns3/ptr.h"
+#include "ns3/random-variable-stream.h"
+
+namespace ns3 {
+
+    class Socket;
+
+    class Packet;
+
+/**
+ * \ingroup applications
+ * \defgroup requestresponse RequestResponseClient
+ *
+ * Closed loop request/response workload: The client opens Concurrency TCP
+ * connections to a RequestResponseServer. Every connection has exactly one
+ * transaction outstanding: it sends a request, waits for the complete
+ * response and sends the next request right away. Request and response
+ * sizes are drawn from random variables, so fixed and variable sizes are
+ * possible.
+ *
+ * Every request starts with an 8 byte header holding the size of the
+ * request and the size of the response the server shall send (both
+ * 32 bit, network byte order). Requests are at least as large as the header.
+ *
+ * The latency of every transaction (first byte of the request handed to the
+ * socket until the last byte of the response received) is recorded in a
+ * histogram, which is allocated when the application starts. Latencies
+ * larger than the histogram are counted in an overflow bucket.
+ */
+
+/**
+ * \ingroup requestresponse
+ *
+ * \brief Issue request/response transactions and measure their latency.
+ */
+    class RequestResponseClient : public Application {
+    public:
+        /**
+         * \brief Get the type ID.
+         * \return the object TypeId
+         */
+        static TypeId GetTypeId(void);
+
+        RequestResponseClient();
+
+        virtual ~RequestResponseClient();
+
+        /**
+         * \return the number of completed transactions
+         */
+        uint64_t GetTransactions(void) const;
+
+        /**
+         * \return the request and response bytes of the completed transactions
+         */
+        uint64_t GetDeliveredBytes(void) const;
+
+        /**
+         * Call back once as soon as the last of MaxTransactions transactions has completed.
+         * Never called if the number of transactions is not limited.
+         *
+         * \param callback called with the request and response bytes delivered so far
+         */
+        void SetCompleteCallback(Callback<void, uint64_t> callback);
+
+        /**
+         * Print transactions per second and the latency percentiles as JSON object.
+         *
+         * \param os the stream to print to
+         */
+        void PrintJson(std::ostream &os) const;
+
+    protected:
+        virtual void DoDispose(void);
+
+    private:
+        // inherited from Application base class.
+        virtual void StartApplication(void);    // Called at time specified by Start
+        virtual void StopApplication(void);     // Called at time specified by Stop
+
+        /// One of the connections, with its outstanding transaction
+        struct Connection {
+            Ptr<Socket> socket;     //!< The socket of the connection
+            bool connected;         //!< True if connected
+            bool headerPending;     //!< True if the header of the request has not been sent yet
+            uint32_t requestSize;   //!< Size of the outstanding request
+            uint32_t responseSize;  //!< Size of the response to the outstanding request
+            uint32_t txPending;     //!< Bytes of the request not handed to the socket yet
+            uint32_t rxPending;     //!< Bytes of the response not received yet
+            Time sent;              //!< Time the outstanding request was started
+        };
+
+        /**
+         * \brief Start the next transaction on a connection, if the limit has not been reached.
+         * \param connection the connection
+         */
+        void SendRequest(Connection &connection);
+
+        /**
+         * \brief Hand as much of the outstanding request to the socket as fits into its buffer.
+         * \param connection the connection
+         */
+        void SendPending(Connection &connection);
+
+        /**
+         * \brief Account the latency of a completed transaction.
+         * \param latency the latency of the transaction
+         */
+        void Record(Time latency);
+
+        /**
+         * \brief Find the connection a socket belongs to.
+         * \param socket the socket
+         * \return the connection, 0 if the socket is unknown
+         */
+        Connection *FindConnection(Ptr<Socket> socket);
+
+        /**
+         * \brief Get the latency below which a share of the transactions completed.
+         * \param percentile the share of the transactions in percent
+         * \return the latency in ms (upper bound of the histogram bucket)
+         */
+        double GetPercentile(double percentile) const;
+
+        void ConnectionSucceeded(Ptr<Socket> socket);   //!< Socket callback, connection established
+        void ConnectionFailed(Ptr<Socket> socket);      //!< Socket callback, connection failed
+        void DataSend(Ptr<Socket> socket, uint32_t);    //!< Socket callback, send buffer space available
+        void HandleRead(Ptr<Socket> socket);            //!< Socket callback, response data received
+
+        Address m_peer;                         //!< Address of the server
+        uint32_t m_concurrency;                 //!< Number of connections (outstanding transactions)
+        Ptr<RandomVariableStream> m_requestSize;    //!< Size of the requests
+        Ptr<RandomVariableStream> m_responseSize;   //!< Size of the responses
+        uint64_t m_maxTransactions;             //!< Limit of transactions to start (0: unlimited)
+        Time m_resolution;                      //!< Width of a histogram bucket
+        uint32_t m_buckets;                     //!< Number of histogram buckets
+
+        std::vector<Connection> m_connections;  //!< The connections
+        std::vector<uint64_t> m_histogram;      //!< Latency histogram, the last bucket counts overflows
+        uint64_t m_started;                     //!< Transactions started
+        uint64_t m_completed;                   //!< Transactions completed
+        uint64_t m_deliveredBytes;              //!< Request and response bytes of the completed transactions
+        Callback<void, uint64_t> m_completeCallback;    //!< Called when the last transaction completed
+        Time m_latencySum;                      //!< Sum of all latencies
+        Time m_latencyMin;                      //!< Smallest latency
+        Time m_latencyMax;                      //!< Largest latency
+        Time m_start;                           //!< Time the application started
+        Time m_lastCompletion;                  //!< Time the last transaction completed
+    };
+
+} // namespace ns3
+
+#endif /* REQUEST_RESPONSE_CLIENT_H */
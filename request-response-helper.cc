@@ -0,0 +1,76 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "request-response-helper.h"
+#include "ns3/node.h"
+
+namespace ns3 {
+
+    RequestResponseClientHelper::RequestResponseClientHelper(Address address) {
+        m_factory.SetTypeId("ns3::RequestResponseClient");
+        m_factory.Set("Remote", AddressValue(address));
+    }
+
+    void
+    RequestResponseClientHelper::SetAttribute(std::string name, const AttributeValue &value) {
+        m_factory.Set(name, value);
+    }
+
+    ApplicationContainer
+    RequestResponseClientHelper::Install(Ptr<Node> node) const {
+        Ptr<Application> app = m_factory.Create<Application>();
+        node->AddApplication(app);
+        return ApplicationContainer(app);
+    }
+
+    ApplicationContainer
+    RequestResponseClientHelper::Install(NodeContainer c) const {
+        ApplicationContainer apps;
+        for (NodeContainer::Iterator i = c.Begin(); i != c.End(); ++i) {
+            apps.Add(Install(*i));
+        }
+
+        return apps;
+    }
+
+    RequestResponseServerHelper::RequestResponseServerHelper(Address address) {
+        m_factory.SetTypeId("ns3::RequestResponseServer");
+        m_factory.Set("Local", AddressValue(address));
+    }
+
+    void
+    RequestResponseServerHelper::SetAttribute(std::string name, const AttributeValue &value) {
+        m_factory.Set(name, value);
+    }
+
+    ApplicationContainer
+    RequestResponseServerHelper::Install(Ptr<Node> node) const {
+        Ptr<Application> app = m_factory.Create<Application>();
+        node->AddApplication(app);
+        return ApplicationContainer(app);
+    }
+
+    ApplicationContainer
+    RequestResponseServerHelper::Install(NodeContainer c) const {
+        ApplicationContainer apps;
+        for (NodeContainer::Iterator i = c.Begin(); i != c.End(); ++i) {
+            apps.Add(Install(*i));
+        }
+
+        return apps;
+    }
+
+} // namespace ns3
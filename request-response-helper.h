@@ -0,0 +1,121 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef REQUEST_RESPONSE_HELPER_H
+#define REQUEST_RESPONSE_HELPER_H
+
+#include <stdint.h>
+#include <string>
+#include "ns3/object-factory.h"
+#include "ns3/address.h"
+#include "ns3/attribute.h"
+#include "ns3/node-container.h"
+#include "ns3/application-container.h"
+
+namespace ns3 {
+
+/**
+ * \ingroup requestresponse
+ * \brief A helper to make it easier to instantiate an ns3::RequestResponseClient
+ * on a set of nodes.
+ */
+    class RequestResponseClientHelper {
+    public:
+        /**
+         * Create a RequestResponseClientHelper to make it easier to work with RequestResponseClients
+         *
+         * \param address the address of the server
+         */
+        RequestResponseClientHelper(Address address);
+
+        /**
+         * Helper function used to set the underlying application attributes,
+         * _not_ the socket attributes.
+         *
+         * \param name the name of the application attribute to set
+         * \param value the value of the application attribute to set
+         */
+        void SetAttribute(std::string name, const AttributeValue &value);
+
+        /**
+         * Install an ns3::RequestResponseClient on each node of the input container
+         * configured with all the attributes set with SetAttribute.
+         *
+         * \param c NodeContainer of the set of nodes on which a RequestResponseClient
+         * will be installed.
+         * \returns Container of Ptr to the applications installed.
+         */
+        ApplicationContainer Install(NodeContainer c) const;
+
+        /**
+         * Install an ns3::RequestResponseClient on the node configured with all the
+         * attributes set with SetAttribute.
+         *
+         * \param node The node on which a RequestResponseClient will be installed.
+         * \returns Container of Ptr to the applications installed.
+         */
+        ApplicationContainer Install(Ptr<Node> node) const;
+
+    private:
+        ObjectFactory m_factory; //!< Object factory.
+    };
+
+/**
+ * \ingroup requestresponse
+ * \brief A helper to make it easier to instantiate an ns3::RequestResponseServer
+ * on a set of nodes.
+ */
+    class RequestResponseServerHelper {
+    public:
+        /**
+         * Create a RequestResponseServerHelper to make it easier to work with RequestResponseServers
+         *
+         * \param address the address the server listens on
+         */
+        RequestResponseServerHelper(Address address);
+
+        /**
+         * Helper function used to set the underlying application attributes.
+         *
+         * \param name the name of the application attribute to set
+         * \param value the value of the application attribute to set
+         */
+        void SetAttribute(std::string name, const AttributeValue &value);
+
+        /**
+         * Install an ns3::RequestResponseServer on each node of the input container.
+         *
+         * \param c NodeContainer of the set of nodes on which a RequestResponseServer
+         * will be installed.
+         * \returns Container of Ptr to the applications installed.
+         */
+        ApplicationContainer Install(NodeContainer c) const;
+
+        /**
+         * Install an ns3::RequestResponseServer on the node.
+         *
+         * \param node The node on which a RequestResponseServer will be installed.
+         * \returns Container of Ptr to the applications installed.
+         */
+        ApplicationContainer Install(Ptr<Node> node) const;
+
+    private:
+        ObjectFactory m_factory; //!< Object factory.
+    };
+
+} // namespace ns3
+
+#endif /* REQUEST_RESPONSE_HELPER_H */
@@ -0,0 +1,207 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// Kommunikation in verteilten Systemen - Request/response workload
+// TCP delivers a byte stream, so requests may be split across or merged into packets arbitrarily. Only the
+// header bytes of a request are copied out of the packets, the rest is skipped by counting.
+
+#include <algorithm>
+#include "ns3/log.h"
+#include "ns3/address.h"
+#include "ns3/node.h"
+#include "ns3/socket.h"
+#include "ns3/simulator.h"
+#include "ns3/packet.h"
+#include "ns3/inet-socket-address.h"
+#include "ns3/inet6-socket-address.h"
+#include "ns3/tcp-socket-factory.h"
+#include "request-response-server.h"
+
+namespace ns3 {
+
+    NS_LOG_COMPONENT_DEFINE ("RequestResponseServer");
+
+    NS_OBJECT_ENSURE_REGISTERED (RequestResponseServer);
+
+    TypeId
+    RequestResponseServer::GetTypeId(void) {
+        static TypeId tid = TypeId("ns3::RequestResponseServer")
+                .SetParent<Application>()
+                .SetGroupName("Applications")
+                .AddConstructor<RequestResponseServer>()
+                .AddAttribute("Local", "The address on which to bind the listening socket.",
+                              AddressValue(),
+                              MakeAddressAccessor(&RequestResponseServer::m_local),
+                              MakeAddressChecker());
+        return tid;
+    }
+
+    RequestResponseServer::RequestResponseServer()
+            : m_socket(0),
+              m_requests(0) {
+        NS_LOG_FUNCTION (this);
+    }
+
+    RequestResponseServer::~RequestResponseServer() {
+        NS_LOG_FUNCTION (this);
+    }
+
+    uint64_t
+    RequestResponseServer::GetRequests(void) const {
+        return m_requests;
+    }
+
+    void
+    RequestResponseServer::DoDispose(void) {
+        NS_LOG_FUNCTION (this);
+
+        m_socket = 0;
+        m_connections.clear();
+        // chain up
+        Application::DoDispose();
+    }
+
+// Application Methods
+    void RequestResponseServer::StartApplication(void) // Called at time specified by Start
+    {
+        NS_LOG_FUNCTION (this);
+
+        if (!m_socket) {
+            m_socket = Socket::CreateSocket(GetNode(), TcpSocketFactory::GetTypeId());
+            if (m_socket->Bind(m_local) == -1) {
+                NS_FATAL_ERROR ("Failed to bind socket");
+            }
+            m_socket->Listen();
+        }
+        m_socket->SetAcceptCallback(
+                MakeNullCallback<bool, Ptr<Socket>, const Address &>(),
+                MakeCallback(&RequestResponseServer::HandleAccept, this));
+    }
+
+    void RequestResponseServer::StopApplication(void) // Called at time specified by Stop
+    {
+        NS_LOG_FUNCTION (this);
+
+        for (std::map<Ptr<Socket>, Connection>::iterator i = m_connections.begin(); i != m_connections.end(); ++i) {
+            i->first->Close();
+        }
+        m_connections.clear();
+        if (m_socket) {
+            m_socket->Close();
+            m_socket->SetAcceptCallback(
+                    MakeNullCallback<bool, Ptr<Socket>, const Address &>(),
+                    MakeNullCallback<void, Ptr<Socket>, const Address &>());
+        }
+    }
+
+// Private helpers
+
+    void RequestResponseServer::HandleAccept(Ptr<Socket> socket, const Address &from) {
+        NS_LOG_FUNCTION (this << socket << from);
+
+        Connection connection;
+        connection.headerBytes = 0;
+        connection.rxPending = 0;
+        connection.responseSize = 0;
+        connection.txPending = 0;
+        m_connections[socket] = connection;
+
+        socket->SetRecvCallback(MakeCallback(&RequestResponseServer::HandleRead, this));
+        socket->SetSendCallback(MakeCallback(&RequestResponseServer::DataSend, this));
+        socket->SetCloseCallbacks(
+                MakeCallback(&RequestResponseServer::HandleClose, this),
+                MakeCallback(&RequestResponseServer::HandleClose, this));
+    }
+
+    void RequestResponseServer::HandleRead(Ptr<Socket> socket) {
+        NS_LOG_FUNCTION (this << socket);
+
+        std::map<Ptr<Socket>, Connection>::iterator found = m_connections.find(socket);
+        if (found == m_connections.end()) {
+            return;
+        }
+        Connection &connection = found->second;
+
+        Ptr<Packet> packet;
+        while ((packet = socket->Recv())) {
+            uint32_t offset = 0;
+            uint32_t size = packet->GetSize();
+            if (size == 0) {
+                break;
+            }
+            while (offset < size) {
+                if (connection.headerBytes < 8) {
+                    // Copy the header out of the packet, it may be split across packets
+                    uint32_t length = std::min(8 - connection.headerBytes, size - offset);
+                    packet->CreateFragment(offset, length)->CopyData(connection.header + connection.headerBytes, length);
+                    connection.headerBytes += length;
+                    offset += length;
+                    if (connection.headerBytes < 8) {
+                        break;
+                    }
+                    uint32_t requestSize = 0;
+                    connection.responseSize = 0;
+                    for (int i = 0; i < 4; ++i) {
+                        requestSize = (requestSize << 8) | connection.header[i];
+                        connection.responseSize = (connection.responseSize << 8) | connection.header[4 + i];
+                    }
+                    connection.rxPending = std::max<uint32_t>(requestSize, 8) - 8;
+                } else {
+                    uint32_t length = std::min(connection.rxPending, size - offset);
+                    connection.rxPending -= length;
+                    offset += length;
+                }
+
+                if (connection.rxPending == 0) {
+                    // Request complete, answer it and expect the header of the next one
+                    m_requests++;
+                    connection.txPending += connection.responseSize;
+                    connection.headerBytes = 0;
+                }
+            }
+        }
+        SendPending(socket, connection);
+    }
+
+    void RequestResponseServer::SendPending(Ptr<Socket> socket, Connection &connection) {
+        while (connection.txPending > 0) {
+            uint32_t toSend = std::min(connection.txPending, socket->GetTxAvailable());
+            if (toSend == 0) {
+                // The send buffer is full, DataSend will call us again
+                break;
+            }
+            int actual = socket->Send(Create<Packet>(toSend));
+            if (actual <= 0) {
+                break;
+            }
+            connection.txPending -= actual;
+        }
+    }
+
+    void RequestResponseServer::DataSend(Ptr<Socket> socket, uint32_t) {
+        NS_LOG_FUNCTION (this);
+        std::map<Ptr<Socket>, Connection>::iterator found = m_connections.find(socket);
+        if (found != m_connections.end()) {
+            SendPending(socket, found->second);
+        }
+    }
+
+    void RequestResponseServer::HandleClose(Ptr<Socket> socket) {
+        NS_LOG_FUNCTION (this << socket);
+        m_connections.erase(socket);
+    }
+
+} // Namespace ns3
@@ -0,0 +1,93 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef REQUEST_RESPONSE_SERVER_H
+#define REQUEST_RESPONSE_SERVER_H
+
+#include <map>
+#include "ns3/address.h"
+#include "ns3/application.h"
+#include "ns3/ptr.h"
+
+namespace ns3 {
+
+    class Socket;
+
+/**
+ * \ingroup requestresponse
+ *
+ * \brief Answer the requests of RequestResponseClients.
+ *
+ * The server accepts any number of TCP connections on its port. It parses the
+ * header at the beginning of every request (see RequestResponseClient) and
+ * sends a response of the requested size as soon as the whole request has
+ * been received.
+ */
+    class RequestResponseServer : public Application {
+    public:
+        /**
+         * \brief Get the type ID.
+         * \return the object TypeId
+         */
+        static TypeId GetTypeId(void);
+
+        RequestResponseServer();
+
+        virtual ~RequestResponseServer();
+
+        /**
+         * \return the number of requests answered
+         */
+        uint64_t GetRequests(void) const;
+
+    protected:
+        virtual void DoDispose(void);
+
+    private:
+        // inherited from Application base class.
+        virtual void StartApplication(void);    // Called at time specified by Start
+        virtual void StopApplication(void);     // Called at time specified by Stop
+
+        /// Parser state of an accepted connection
+        struct Connection {
+            uint8_t header[8];      //!< Header of the current request
+            uint32_t headerBytes;   //!< Bytes of the header received so far
+            uint32_t rxPending;     //!< Bytes of the current request not received yet
+            uint32_t responseSize;  //!< Size of the response to the current request
+            uint32_t txPending;     //!< Bytes of responses not handed to the socket yet
+        };
+
+        /**
+         * \brief Hand as much of the pending responses to the socket as fits into its buffer.
+         * \param socket the socket of the connection
+         * \param connection the connection
+         */
+        void SendPending(Ptr<Socket> socket, Connection &connection);
+
+        void HandleAccept(Ptr<Socket> socket, const Address &from);    //!< Socket callback, connection accepted
+        void HandleRead(Ptr<Socket> socket);                            //!< Socket callback, request data received
+        void DataSend(Ptr<Socket> socket, uint32_t);                    //!< Socket callback, send buffer space available
+        void HandleClose(Ptr<Socket> socket);                           //!< Socket callback, connection closed
+
+        Address m_local;                                    //!< Local address to bind to
+        Ptr<Socket> m_socket;                               //!< Listening socket
+        std::map<Ptr<Socket>, Connection> m_connections;    //!< Accepted connections
+        uint64_t m_requests;                                //!< Requests answered
+    };
+
+} // namespace ns3
+
+#endif /* REQUEST_RESPONSE_SERVER_H */
@@ -0,0 +1,116 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// Kommunikation in verteilten Systemen - Routing overhead
+// OLSR (UDP 698), AODV (UDP 654) and DSDV (UDP 269) exchange their control messages via UDP sockets,
+// so their packets can be told apart by port. DSR is an IP protocol of its own (48) which also carries
+// the data packets, its fixed header tells control (1) and data (2) messages apart.
+
+#include "ns3/log.h"
+#include "ns3/callback.h"
+#include "ns3/node.h"
+#include "ns3/ipv4-header.h"
+#include "ns3/ipv4-l3-protocol.h"
+#include "ns3/udp-header.h"
+#include "ns3/udp-l4-protocol.h"
+#include "ns3/dsr-fs-header.h"
+#include "ns3/dsr-routing.h"
+#include "routing-overhead-stats.h"
+
+namespace ns3 {
+
+    NS_LOG_COMPONENT_DEFINE ("RoutingOverheadStats");
+
+    static const uint16_t OLSR_PORT = 698;
+    static const uint16_t AODV_PORT = 654;
+    static const uint16_t DSDV_PORT = 269;
+    static const uint8_t DSR_CONTROL_MESSAGE = 1;
+
+    RoutingOverheadStats::RoutingOverheadStats()
+            : m_controlPackets(0),
+              m_controlBytes(0),
+              m_dataPackets(0),
+              m_dataBytes(0) {
+    }
+
+    void
+    RoutingOverheadStats::Install(NodeContainer nodes) {
+        for (NodeContainer::Iterator i = nodes.Begin(); i != nodes.End(); ++i) {
+            Ptr<Ipv4L3Protocol> ipv4 = (*i)->GetObject<Ipv4L3Protocol>();
+            NS_ASSERT_MSG (ipv4, "RoutingOverheadStats needs the internet stack to be installed");
+            ipv4->TraceConnectWithoutContext("Tx", MakeCallback(&RoutingOverheadStats::IpTx, this));
+        }
+    }
+
+    bool
+    RoutingOverheadStats::IsRoutingControl(Ptr<const Packet> packet) {
+        Ptr<Packet> copy = packet->Copy();
+        Ipv4Header ipHeader;
+        copy->RemoveHeader(ipHeader);
+        return ClassifyControl(ipHeader.GetProtocol(), copy) != NO_CONTROL;
+    }
+
+    RoutingOverheadStats::ControlProtocol
+    RoutingOverheadStats::ClassifyControl(uint8_t protocol, Ptr<const Packet> payload) {
+        if (protocol == UdpL4Protocol::PROT_NUMBER) {
+            UdpHeader udpHeader;
+            payload->PeekHeader(udpHeader);
+            switch (udpHeader.GetDestinationPort()) {
+                case OLSR_PORT:
+                    return OLSR;
+                case AODV_PORT:
+                    return AODV;
+                case DSDV_PORT:
+                    return DSDV;
+                default:
+                    return NO_CONTROL;
+            }
+        }
+        if (protocol == dsr::DsrRouting::PROT_NUMBER) {
+            dsr::DsrFsHeader dsrHeader;
+            payload->PeekHeader(dsrHeader);
+            return dsrHeader.GetMessageType() == DSR_CONTROL_MESSAGE ? DSR : NO_CONTROL;
+        }
+        return NO_CONTROL;
+    }
+
+    void
+    RoutingOverheadStats::IpTx(Ptr<const Packet> packet, Ptr<Ipv4> ipv4, uint32_t interface) {
+        if (IsRoutingControl(packet)) {
+            m_controlPackets++;
+            m_controlBytes += packet->GetSize();
+        } else {
+            m_dataPackets++;
+            m_dataBytes += packet->GetSize();
+        }
+    }
+
+    uint64_t
+    RoutingOverheadStats::GetControlBytes(void) const {
+        return m_controlBytes;
+    }
+
+    void
+    RoutingOverheadStats::PrintJson(std::ostream &os) const {
+        os << "{";
+        os << "\"control_packets\":" << m_controlPackets << ",";
+        os << "\"control_bytes\":" << m_controlBytes << ",";
+        os << "\"data_packets\":" << m_dataPackets << ",";
+        os << "\"data_bytes\":" << m_dataBytes;
+        os << "}";
+    }
+
+} // namespace ns3
@@ -0,0 +1,100 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef ROUTING_OVERHEAD_STATS_H
+#define ROUTING_OVERHEAD_STATS_H
+
+#include <ostream>
+#include "ns3/ptr.h"
+#include "ns3/packet.h"
+#include "ns3/ipv4.h"
+#include "ns3/node-container.h"
+
+namespace ns3 {
+
+/**
+ * \brief Count the IP packets sent by the routing protocol (control) and everything else (data).
+ *
+ * Every packet leaving the IP layer of an installed node (including forwarded
+ * packets and retransmissions of the transport layer) is classified once.
+ * OLSR, AODV and DSDV are recognised by their well-known UDP ports, DSR by the
+ * message type of its fixed header. Sizes include the IP header.
+ */
+    class RoutingOverheadStats {
+    public:
+        RoutingOverheadStats();
+
+        /**
+         * Connect to the Ipv4L3Protocol Tx trace of every node in the container.
+         * The internet stack has to be installed already.
+         *
+         * \param nodes the nodes to count packets of
+         */
+        void Install(NodeContainer nodes);
+
+        /**
+         * Print the counters as JSON object.
+         *
+         * \param os the stream to print to
+         */
+        void PrintJson(std::ostream &os) const;
+
+        /**
+         * \return the bytes of all routing control packets sent so far
+         */
+        uint64_t GetControlBytes(void) const;
+
+        /// Routing protocols whose control packets can be recognised
+        enum ControlProtocol {
+            NO_CONTROL, //!< The packet does not belong to a routing protocol
+            OLSR,       //!< OLSR (UDP port 698)
+            AODV,       //!< AODV (UDP port 654)
+            DSDV,       //!< DSDV (UDP port 269)
+            DSR         //!< DSR control message (IP protocol 48)
+        };
+
+        /**
+         * \param packet an IPv4 packet, starting with its IP header
+         * \return true if the packet has been sent by a routing protocol
+         */
+        static bool IsRoutingControl(Ptr<const Packet> packet);
+
+        /**
+         * \param protocol the protocol number of the IP header
+         * \param payload the payload of the IP packet (without IP header)
+         * \return the routing protocol which sent the packet, or NO_CONTROL
+         */
+        static ControlProtocol ClassifyControl(uint8_t protocol, Ptr<const Packet> payload);
+
+    private:
+        /**
+         * Trace sink for the Ipv4L3Protocol Tx trace source.
+         *
+         * \param packet the packet, including its IP header
+         * \param ipv4 the IPv4 stack of the sending node
+         * \param interface the interface the packet is sent on
+         */
+        void IpTx(Ptr<const Packet> packet, Ptr<Ipv4> ipv4, uint32_t interface);
+
+        uint64_t m_controlPackets;  //!< Number of routing control packets
+        uint64_t m_controlBytes;    //!< Bytes of routing control packets
+        uint64_t m_dataPackets;     //!< Number of other packets
+        uint64_t m_dataBytes;       //!< Bytes of other packets
+    };
+
+} // namespace ns3
+
+#endif /* ROUTING_OVERHEAD_STATS_H */
@@ -0,0 +1,107 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// Kommunikation in verteilten Systemen - Scheduler selection
+// Every event of the simulation (PHY receptions, OLSR and TCP timers, ...) is inserted into and removed from the
+// scheduler once, so its cost per operation directly adds to the runtime of large simulations.
+// For profiling, the chosen scheduler is wrapped by the ProfilingScheduler.
+
+#include <chrono>
+#include <iostream>
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+#include "ns3/object-factory.h"
+#include "ns3/pointer.h"
+#include "scheduler-helper.h"
+
+namespace ns3 {
+
+    NS_LOG_COMPONENT_DEFINE ("SchedulerHelper");
+
+    SchedulerHelper::SchedulerHelper()
+            : m_scheduler("map"),
+              m_events(0),
+              m_wallSeconds(0.0),
+              m_top(0) {
+    }
+
+    void
+    SchedulerHelper::SetScheduler(std::string scheduler) {
+        m_scheduler = scheduler;
+    }
+
+    void
+    SchedulerHelper::SetProfile(uint32_t top) {
+        m_top = top;
+        m_profile = 0;
+        if (top > 0) {
+            m_profile = CreateObject<SchedulerProfile>();
+        }
+    }
+
+    void
+    SchedulerHelper::Configure(void) const {
+        ObjectFactory factory;
+        if (m_scheduler == "heap") {
+            factory.SetTypeId("ns3::HeapScheduler");
+        } else if (m_scheduler == "map") {
+            factory.SetTypeId("ns3::MapScheduler");
+        } else if (m_scheduler == "list") {
+            factory.SetTypeId("ns3::ListScheduler");
+        } else if (m_scheduler == "calendar") {
+            factory.SetTypeId("ns3::CalendarScheduler");
+        } else {
+            NS_FATAL_ERROR("Unknown scheduler " << m_scheduler);
+        }
+        if (m_profile) {
+            TypeId scheduler = factory.GetTypeId();
+            factory.SetTypeId("ns3::ProfilingScheduler");
+            factory.Set("Scheduler", TypeIdValue(scheduler));
+            factory.Set("Profile", PointerValue(m_profile));
+        }
+        Simulator::SetScheduler(factory);
+    }
+
+    void
+    SchedulerHelper::Run(void) {
+        uint64_t events = Simulator::GetEventCount();
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        Simulator::Run();
+        std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+        m_wallSeconds = std::chrono::duration<double>(end - start).count();
+        m_events = Simulator::GetEventCount() - events;
+
+        if (m_profile) {
+            m_profile->Finish();
+            m_profile->PrintReport(std::cerr, m_top);
+        }
+    }
+
+    void
+    SchedulerHelper::PrintJson(std::ostream &os) const {
+        os << "{";
+        os << "\"scheduler\":\"" << m_scheduler << "\",";
+        os << "\"events\":" << m_events << ",";
+        os << "\"wall_ms\":" << m_wallSeconds * 1000.0 << ",";
+        os << "\"events_per_s\":" << (m_wallSeconds > 0.0 ? m_events / m_wallSeconds : 0.0);
+        if (m_profile) {
+            os << ",\"profile\":";
+            m_profile->PrintJson(os, m_top);
+        }
+        os << "}";
+    }
+
+} // namespace ns3
@@ -0,0 +1,80 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef SCHEDULER_HELPER_H
+#define SCHEDULER_HELPER_H
+
+#include <ostream>
+#include <string>
+#include <stdint.h>
+#include "ns3/ptr.h"
+#include "profiling-scheduler.h"
+
+namespace ns3 {
+
+/**
+ * \brief Select the event scheduler of the simulator and measure how fast the simulation runs.
+ *
+ * Supported schedulers are heap, map (ns3's default), list and calendar. Run replaces
+ * Simulator::Run and measures the wall clock time the simulation takes and the number
+ * of events executed.
+ *
+ * If profiling is enabled, the scheduler is wrapped by a ProfilingScheduler, which
+ * accounts the wall clock time to the types of the events executed.
+ */
+    class SchedulerHelper {
+    public:
+        SchedulerHelper();
+
+        /**
+         * \param scheduler heap, map, list or calendar
+         */
+        void SetScheduler(std::string scheduler);
+
+        /**
+         * \param top print the top event types by wall clock time after the run; 0 disables profiling
+         */
+        void SetProfile(uint32_t top);
+
+        /**
+         * Install the scheduler. Must be called before the simulation is started.
+         */
+        void Configure(void) const;
+
+        /**
+         * Run the simulation (Simulator::Run) and measure it.
+         * If profiling is enabled, the profile is printed to std::cerr afterwards.
+         */
+        void Run(void);
+
+        /**
+         * Print the scheduler, the wall clock time, the events per second and the profile as JSON object.
+         *
+         * \param os the stream to print to
+         */
+        void PrintJson(std::ostream &os) const;
+
+    private:
+        std::string m_scheduler;    //!< Name of the scheduler
+        uint64_t m_events;          //!< Events executed by Run
+        double m_wallSeconds;       //!< Wall clock time Run took
+        uint32_t m_top;             //!< Number of event types to report, 0 if profiling is disabled
+        Ptr<SchedulerProfile> m_profile;    //!< The profile, if profiling is enabled
+    };
+
+} // namespace ns3
+
+#endif /* SCHEDULER_HELPER_H */
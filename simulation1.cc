@@ -14,11 +14,20 @@
  * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
  */
 
-// Network topology
+// Network topology (default)
 //
 //       n0 ----------- n1
 //
-// - Flow from n0 to n1 using BulkSendApplication.
+// --topology=chain --hops=3                   --topology=tree --depth=2 --fanout=2
+//
+//       n0 ---- n1 ---- n2 ---- n3                          n0
+//                                                       /        \
+//                                                     n1          n2
+//                                                    /  \        /  \
+//                                                  n3    n4    n5    n6
+//
+// - Flow from n0 to the last node of the chain, or from every leaf to the root of the tree,
+//   using BulkSendApplication.
 // - Tracing of queues and packet receptions to file "bulk-send.tr"
 //   and pcap tracing available when tracing is turned on.
 
@@ -37,21 +46,72 @@
 // Default value of data_rate was set to 100 Mbps to match the TP Link router's ethernet speed
 // Usage of TCP _and_ UDP protocols is possible
 // BulkSendApplication can now use Udp Sockets by manually scheduling the transmit of packets
+// Results are written to stdout as JSON (like simulation 2 and 3 do), with the same packet counts as simulation 3
+// Using --queue_disc={pfifo_fast,codel,fq_codel,pie} the queue disc on both ends of the link can be chosen
+// (--queue_limit sets its size, e.g. 100p, --device_queue the size of the device queue below it).
+// Packets dropped, maximum occupancy and sojourn time of every queue disc are reported as "queue_discs".
+// Using --probe_interval=<ms> a ping runs next to the transfer, its RTTs are reported as "probe".
+// Using --connections=<k> the BulkSender opens k parallel TCP connections and stripes maxBytes across them. Bytes,
+// throughput and completion time of every connection and of all of them together are reported as "connections".
+// Using --scheduler={heap,map,list,calendar} the event scheduler can be chosen. Events executed, wall clock time
+// and events per second of the run are reported as "simulator".
+// Using --profile=<n> the wall clock time of the run is accounted to the types of the events executed (the class and
+// signature of the scheduled member function, or the signature of the scheduled function, and the bound argument
+// types; timers of the same class and signature share a row), the top n are printed to stderr and reported as
+// "profile" inside "simulator".
+// Using --tcp_variant={newreno,westwood,westwoodplus,vegas,bic,hybla,highspeed,...} the TCP congestion control can be
+// chosen, --sack, --window_scaling, --segment_size, --snd_buf and --rcv_buf set the socket options. The TCP
+// configuration is reported as "tcp".
+// Using --topology=chain --hops=<n> the nodes are connected in a chain of n links, using --topology=tree --depth=<d>
+// --fanout=<f> in a tree, where every leaf sends maxBytes to the root. --data_rate, --delay and --device_queue take
+// comma separated lists, one value per link (the last value applies to all further links), --links=<file> overrides
+// them with one line "<rate> <delay> [<queue>]" per link. Every link gets its own subnet, packets are forwarded by
+// global routing. The topology is reported as "topology", the load of every link direction as "links".
 
 #include <string>
 #include <fstream>
+#include <iostream>
 #include "ns3/core-module.h"
 #include "ns3/point-to-point-module.h"
 #include "ns3/internet-module.h"
 #include "ns3/applications-module.h"
 #include "ns3/network-module.h"
-#include "ns3/packet-sink.h"
+#include "ns3/traffic-control-module.h"
 #include "custom-bulk-send-helper.h"
+#include "queue-disc-stats.h"
+#include "latency-probe.h"
+#include "tcp-config-helper.h"
+#include "counting-sink-helper.h"
+#include "connection-stats.h"
+#include "scheduler-helper.h"
+#include "p2p-topology-helper.h"
+#include "p2p-link-stats.h"
 
 using namespace ns3;
 
 NS_LOG_COMPONENT_DEFINE ("BulkSendExample");
 
+// Packets handed to the sockets by the senders (like simulation 3)
+ns3::Time last_time_tx;
+uint64_t packet_count_tx = 0;
+uint64_t packet_size_tx = 0;
+void TxPacket(Ptr<const Packet> packet) {
+    last_time_tx = Simulator::Now();
+    packet_count_tx++;
+    packet_size_tx += packet->GetSize();
+}
+
+// Queue disc accounting, the window is closed as soon as maxBytes have been received
+QueueDiscStats queue_disc_stats;
+// Load of every link, closed at the same time
+PointToPointLinkStats link_stats;
+
+// Called once by the sink, as soon as maxBytes have been received from every source
+void TransferComplete(uint64_t rx_bytes) {
+    queue_disc_stats.SetWindowEnd(Simulator::Now());
+    link_stats.SetWindowEnd(Simulator::Now());
+}
+
 int
 main(int argc, char *argv[]) {
     // This activates packet logging to ascii and pcap files
@@ -70,6 +130,36 @@ main(int argc, char *argv[]) {
     // P2P-links I'll keep it like that. Can be configured via command line just in case!
     std::string delay = "5ms";
 
+    // Topology: chain (the default of one hop is the single link of the example) or tree
+    std::string topology = "chain";
+    uint32_t hops = 1;
+    uint32_t depth = 2;
+    uint32_t fanout = 2;
+    // File with the rate, delay and queue size of every link (empty: use the lists above)
+    std::string links = "";
+
+    // Queue disc on the link: pfifo_fast (ns3's default), codel, fq_codel or pie, and its size (e.g. 100p)
+    std::string queue_disc = "pfifo_fast";
+    std::string queue_limit = "";
+    // Size of the device queue below the queue disc (empty: ns3's default of 100 packets)
+    std::string device_queue = "";
+    // Interval of the latency probe in ms (0 disables it)
+    uint32_t probe_interval = 0;
+    // Number of parallel TCP connections maxBytes is striped across
+    uint32_t connections = 1;
+    // Event scheduler: heap, map (ns3's default), list or calendar
+    std::string scheduler = "map";
+    // Report the n event types which took most of the wall clock time (0: no profiling)
+    uint32_t profile = 0;
+    // TCP congestion control (newreno, westwood, westwoodplus, vegas, bic, hybla, highspeed, htcp, scalable, veno,
+    // yeah, illinois, ledbat, lp), options, maximum segment size and socket buffer sizes (defaults: ns3's)
+    std::string tcp_variant = "newreno";
+    bool sack = true;
+    bool window_scaling = true;
+    uint32_t tcp_segment_size = 536;
+    uint32_t snd_buf = 131072;
+    uint32_t rcv_buf = 131072;
+
     //
     // Allow the user to override any of the defaults at
     // run-time, via command-line arguments
@@ -79,28 +169,75 @@ main(int argc, char *argv[]) {
     cmd.AddValue("maxBytes", "Total number of bytes for application to send", maxBytes);
     cmd.AddValue("send_size", "Bytes sent per packet", send_size);
     cmd.AddValue("socket_factory", "Socket Factory to use. Default is ns3::TcpSocketFactory", socket_factory);
-    cmd.AddValue("data_rate", "Point-to-point link data rate", data_rate);
-    cmd.AddValue("delay", "Point-to-Point connection delay", delay);
+    cmd.AddValue("data_rate", "Point-to-point link data rate, comma separated per link", data_rate);
+    cmd.AddValue("delay", "Point-to-Point connection delay, comma separated per link", delay);
+    cmd.AddValue("topology", "Topology: chain or tree", topology);
+    cmd.AddValue("hops", "Number of links of the chain", hops);
+    cmd.AddValue("depth", "Number of links between the leaves and the root of the tree", depth);
+    cmd.AddValue("fanout", "Number of children of every inner node of the tree", fanout);
+    cmd.AddValue("links", "File with one line \"<rate> <delay> [<queue>]\" per link (empty: use the lists)", links);
+    cmd.AddValue("queue_disc", "Queue disc: pfifo_fast, codel, fq_codel or pie", queue_disc);
+    cmd.AddValue("queue_limit", "Maximum size of the queue disc, e.g. 100p (empty: default of the queue disc)", queue_limit);
+    cmd.AddValue("device_queue", "Maximum size of the device queue, e.g. 1p (empty: 100p), comma separated per link", device_queue);
+    cmd.AddValue("probe_interval", "Send a ping every probe_interval ms next to the transfer (0: off)", probe_interval);
+    cmd.AddValue("connections", "Number of parallel TCP connections maxBytes is striped across", connections);
+    cmd.AddValue("scheduler", "Event scheduler: heap, map, list or calendar", scheduler);
+    cmd.AddValue("profile", "Print the n event types which took most of the wall clock time (0: off)", profile);
+    cmd.AddValue("tcp_variant", "TCP congestion control: newreno, westwood, westwoodplus, vegas, bic, hybla, highspeed, htcp, scalable, veno, yeah, illinois, ledbat or lp", tcp_variant);
+    cmd.AddValue("sack", "Enable TCP selective acknowledgements", sack);
+    cmd.AddValue("window_scaling", "Enable the TCP window scale option", window_scaling);
+    cmd.AddValue("segment_size", "TCP maximum segment size in bytes", tcp_segment_size);
+    cmd.AddValue("snd_buf", "TCP send buffer size in bytes", snd_buf);
+    cmd.AddValue("rcv_buf", "TCP receive buffer size in bytes", rcv_buf);
     cmd.Parse(argc, argv);
 
-    //
-    // Explicitly create the nodes required by the topology (shown above).
-    //
-    NS_LOG_INFO("Create nodes.");
-    NodeContainer nodes;
-    nodes.Create(2);
+    // Must be set before the first TCP socket is created
+    TcpConfigHelper tcpConfig;
+    tcpConfig.SetVariant(tcp_variant);
+    tcpConfig.SetOptions(sack, window_scaling);
+    tcpConfig.SetSegmentSize(tcp_segment_size);
+    tcpConfig.SetBufferSizes(snd_buf, rcv_buf);
+    tcpConfig.Configure();
 
-    NS_LOG_INFO("Create channels.");
+    SchedulerHelper schedulerHelper;
+    schedulerHelper.SetScheduler(scheduler);
+    schedulerHelper.SetProfile(profile);
+    schedulerHelper.Configure();
+
+    std::string queue_disc_type;
+    if (queue_disc == "pfifo_fast") {
+        queue_disc_type = "ns3::PfifoFastQueueDisc";
+    } else if (queue_disc == "codel") {
+        queue_disc_type = "ns3::CoDelQueueDisc";
+    } else if (queue_disc == "fq_codel") {
+        queue_disc_type = "ns3::FqCoDelQueueDisc";
+    } else if (queue_disc == "pie") {
+        queue_disc_type = "ns3::PieQueueDisc";
+    } else {
+        NS_FATAL_ERROR("Unknown queue disc " << queue_disc);
+    }
 
     //
-    // Explicitly create the point-to-point link required by the topology (shown above).
+    // Create the nodes and the point-to-point links required by the topology (shown above).
     //
-    PointToPointHelper pointToPoint;
-    pointToPoint.SetDeviceAttribute("DataRate", StringValue(data_rate));
-    pointToPoint.SetChannelAttribute("Delay", StringValue(delay));
+    NS_LOG_INFO("Create nodes and channels.");
+    PointToPointTopologyHelper topologyHelper;
+    if (topology == "chain") {
+        topologyHelper.SetChain(hops);
+    } else if (topology == "tree") {
+        topologyHelper.SetTree(depth, fanout);
+    } else {
+        NS_FATAL_ERROR("Unknown topology " << topology);
+    }
+    topologyHelper.SetLinkAttributes(data_rate, delay, device_queue);
+    if (!links.empty()) {
+        topologyHelper.ReadLinkFile(links);
+    }
 
-    NetDeviceContainer devices;
-    devices = pointToPoint.Install(nodes);
+    NodeContainer nodes = topologyHelper.Install();
+    NetDeviceContainer devices = topologyHelper.GetDevices();
+    std::vector<uint32_t> sources = topologyHelper.GetSources();
+    Ptr<Node> sinkNode = nodes.Get(topologyHelper.GetSink());
 
     //
     // Install the internet stack on the nodes (IP)
@@ -108,18 +245,40 @@ main(int argc, char *argv[]) {
     InternetStackHelper internet;
     internet.Install(nodes);
 
+    //
+    // Install the queue discs before the addresses are assigned, otherwise ns3 installs its default one
+    //
+    TrafficControlHelper trafficControl;
+    if (queue_limit.empty()) {
+        trafficControl.SetRootQueueDisc(queue_disc_type);
+    } else {
+        trafficControl.SetRootQueueDisc(queue_disc_type, "MaxSize", StringValue(queue_limit));
+    }
+    trafficControl.Install(devices);
+    queue_disc_stats.Install(devices);
+    for (uint32_t l = 0; l < topologyHelper.GetLinks().size(); ++l) {
+        link_stats.Install(topologyHelper.GetLinks()[l]);
+    }
+
     //
     // We've got the "hardware" in place.  Now we need to add IP addresses.
+    // Every link is a subnet of its own (10.1.1.0/24, 10.1.2.0/24, ...).
     //
     NS_LOG_INFO("Assign IP Addresses.");
     Ipv4AddressHelper ipv4;
     ipv4.SetBase("10.1.1.0", "255.255.255.0");
-    Ipv4InterfaceContainer i = ipv4.Assign(devices);
+    for (uint32_t l = 0; l < topologyHelper.GetLinks().size(); ++l) {
+        ipv4.Assign(topologyHelper.GetLinks()[l]);
+        ipv4.NewNetwork();
+    }
+    // The sink is reached by the first address of its first interface (interface 0 is the loopback)
+    Ipv4Address sinkAddress = sinkNode->GetObject<Ipv4>()->GetAddress(1, 0).GetLocal();
+    Ipv4GlobalRoutingHelper::PopulateRoutingTables();
 
     NS_LOG_INFO("Create Applications.");
 
     //
-    // Create a BulkSendApplication and install it on node 0
+    // Create a BulkSendApplication and install it on every source
     // A BulkSendApplication sends as many packets as fast as it can
     // until it reaches a certain, configurable, limit.
     //
@@ -127,29 +286,54 @@ main(int argc, char *argv[]) {
 
 
     CustomBulkSendHelper source(socket_factory,
-                          InetSocketAddress(i.GetAddress(1), port));
+                          InetSocketAddress(sinkAddress, port));
     // Set the amount of data to send in bytes.  Zero is unlimited.
     source.SetAttribute("MaxBytes", UintegerValue(maxBytes));
     // Set the amount of data to send per packet
     source.SetAttribute("SendSize", UintegerValue(send_size));
-    ApplicationContainer sourceApps = source.Install(nodes.Get(0));
+    // The UDP sender has no connections
+    if (socket_factory == "ns3::UdpSocketFactory") {
+        if (connections > 1) {
+            NS_FATAL_ERROR("Parallel connections are only supported for TCP");
+        }
+    } else {
+        source.SetAttribute("Connections", UintegerValue(connections));
+    }
+    ApplicationContainer sourceApps;
+    for (std::vector<uint32_t>::const_iterator s = sources.begin(); s != sources.end(); ++s) {
+        sourceApps.Add(source.Install(nodes.Get(*s)));
+    }
+    for (uint32_t s = 0; s < sourceApps.GetN(); ++s) {
+        sourceApps.Get(s)->TraceConnectWithoutContext("Tx", MakeCallback(&TxPacket));
+    }
     sourceApps.Start(Seconds(0.0));
     sourceApps.Stop(Seconds(10.0));
 
     //
-    // Create a PacketSinkApplication and install it on node 1
+    // Create a CountingSink and install it on the last node of the chain / the root of the tree
     //
-    PacketSinkHelper sink(socket_factory,
-                          InetSocketAddress(Ipv4Address::GetAny(), port));
-    ApplicationContainer sinkApps = sink.Install(nodes.Get(1));
+    CountingSinkHelper sink(socket_factory,
+                            InetSocketAddress(Ipv4Address::GetAny(), port));
+    ApplicationContainer sinkApps = sink.Install(sinkNode);
     sinkApps.Start(Seconds(0.0));
     sinkApps.Stop(Seconds(10.0));
 
+    Ptr<CountingSink> sink1 = DynamicCast<CountingSink>(sinkApps.Get(0));
+    sink1->SetThresholdCallback(static_cast<uint64_t>(maxBytes) * sources.size(), MakeCallback(&TransferComplete));
+    ConnectionStats connection_stats;
+    connection_stats.Install(sink1, Seconds(0.0));
+
+    LatencyProbe probe;
+    if (probe_interval > 0) {
+        probe.Install(nodes.Get(sources.front()), sinkAddress, MilliSeconds(probe_interval), Seconds(0.0), Seconds(10.0));
+    }
+
     //
     // Set up tracing if enabled
     //
     if (tracing) {
         AsciiTraceHelper ascii;
+        PointToPointHelper pointToPoint;
         pointToPoint.EnableAsciiAll(ascii.CreateFileStream("bulk-send.tr"));
         pointToPoint.EnablePcapAll("bulk-send", false);
     }
@@ -163,10 +347,42 @@ main(int argc, char *argv[]) {
     // to transmit inside the simulation. Using a 1Mbps link, this time increses to a little bit under 10s.
     // For every realisic scenario, 10s should be okay.
     Simulator::Stop(Seconds(10.0));
-    Simulator::Run();
+    schedulerHelper.Run();
+    Time simulation_end = Simulator::Now();
     Simulator::Destroy();
     NS_LOG_INFO("Done.");
 
-    Ptr<PacketSink> sink1 = DynamicCast<PacketSink>(sinkApps.Get(0));
-    std::cout << "Total Bytes Received: " << sink1->GetTotalRx() << std::endl;
+    Time last_time_rx = sink1->GetTotal().last;
+    std::cerr << "Total Bytes Received: " << sink1->GetTotalRx() << std::endl;
+    std::cerr << "Last packet received at: " << last_time_rx.GetMilliSeconds() << "ms" << std::endl;
+
+    std::cout << "{";
+    std::cout << "\"rx_bytes_application\":" << sink1->GetTotalRx() << ",";
+    std::cout << "\"rx_ms_last\":" << last_time_rx.GetMilliSeconds() << ",";
+    std::cout << "\"rx_ms_first\":" << sink1->GetTotal().first.GetMilliSeconds() << ",";
+    std::cout << "\"rx_count_packets\":" << sink1->GetTotal().rxPackets << ",";
+    std::cout << "\"rx_bytes_packets\":" << sink1->GetTotal().rxBytes << ",";
+    std::cout << "\"tx_count_packets\":" << packet_count_tx << ",";
+    std::cout << "\"tx_bytes_packets\":" << packet_size_tx << ",";
+    std::cout << "\"tx_ms_last\":" << last_time_tx.GetMilliSeconds() << ",";
+    std::cout << "\"goodput_bps\":"
+              << (last_time_rx.IsStrictlyPositive() ? sink1->GetTotalRx() * 8 / last_time_rx.GetSeconds() : 0.0) << ",";
+    std::cout << "\"topology\":";
+    topologyHelper.PrintJson(std::cout);
+    std::cout << ",\"links\":";
+    link_stats.PrintJson(std::cout, simulation_end);
+    std::cout << ",\"queue_disc\":\"" << queue_disc << "\",";
+    std::cout << "\"queue_discs\":";
+    queue_disc_stats.PrintJson(std::cout);
+    std::cout << ",\"tcp\":";
+    tcpConfig.PrintJson(std::cout);
+    std::cout << ",\"connections\":";
+    connection_stats.PrintJson(std::cout);
+    std::cout << ",\"simulator\":";
+    schedulerHelper.PrintJson(std::cout);
+    if (probe_interval > 0) {
+        std::cout << ",\"probe\":";
+        probe.PrintJson(std::cout);
+    }
+    std::cout << "}";
 }
@@ -40,6 +40,29 @@
 // Export of Wifi frames to PCAP/ASCII is now possible
 // ItuR1411LosPropagationLossModel is used, as it seemed to describe the target scenario the best (see documenation below)
 // BulkSendApplication can now use Udp Sockets by manually scheduling the transmit of packets
+// Results are written to stdout as JSON (like simulation 3 does), with the same packet counts
+// Using the switch --airtime the time every node spends transmitting, receiving, sensing a busy channel and idling
+// is accounted from the YansWifiPhy state traces. The measurement window ends as soon as maxBytes have been received.
+// Using --standard={g,n-2.4,n-5,ac} 802.11n/ac can be simulated instead of 802.11g, with A-MPDU/A-MSDU aggregation
+// (--max_ampdu, --max_amsdu) and wider channels (--channel_width). --rate_manager=constant uses wifi_transmission_mode
+// for all data frames instead of Minstrel (MinstrelHt for 802.11n/ac). The configuration is reported as "wifi".
+// Using --tcp_variant={newreno,westwood,westwoodplus,vegas,bic,hybla,highspeed,...} the TCP congestion control can be
+// chosen, --sack, --window_scaling, --segment_size, --snd_buf and --rcv_buf set the socket options. The TCP
+// configuration is reported as "tcp".
+// Using --connections=<k> the BulkSender opens k parallel TCP connections and stripes maxBytes across them. Bytes,
+// throughput and completion time of every connection and of all of them together are reported as "connections".
+// Using --scheduler={heap,map,list,calendar} the event scheduler can be chosen. Events executed, wall clock time
+// and events per second of the run are reported as "simulator".
+// Using --profile=<n> the wall clock time of the run is accounted to the types of the events executed (the class and
+// signature of the scheduled member function, or the signature of the scheduled function, and the bound argument
+// types; timers of the same class and signature share a row), the top n are printed to stderr and reported as
+// "profile" inside "simulator".
+// Using --energy every node gets a battery (--energy_initial J at --energy_voltage V) its wifi radios draw from
+// (WifiRadioEnergyModel). The energy consumed per node inside the measurement window and the energy per delivered
+// bit are reported as "energy".
+// Using --phy=spectrum the nodes get a SpectrumWifiPhy on a MultiModelSpectrumChannel (same propagation models)
+// instead of a YansWifiPhy. It models the power spectral density of every signal, so adjacent and overlapping
+// channels interfere, at the price of a slower simulation. The PHY is reported as "phy", its cost in "simulator".
 
 #include <string>
 #include <fstream>
@@ -47,18 +70,48 @@
 #include "ns3/internet-module.h"
 #include "ns3/applications-module.h"
 #include "ns3/network-module.h"
-#include "ns3/packet-sink.h"
 #include "ns3/yans-wifi-helper.h"
 #include "ns3/mobility-helper.h"
 #include "ns3/ipv4-address-helper.h"
 #include "ns3/yans-wifi-channel.h"
+#include "ns3/spectrum-wifi-helper.h"
+#include "ns3/multi-model-spectrum-channel.h"
+#include "ns3/itu-r-1411-los-propagation-model.h"
+#include "ns3/propagation-delay-model.h"
 #include "ns3/mobility-model.h"
 #include "custom-bulk-send-helper.h"
+#include "wifi-airtime-stats.h"
+#include "wifi-energy-stats.h"
+#include "wifi-standard-helper.h"
+#include "tcp-config-helper.h"
+#include "counting-sink-helper.h"
+#include "connection-stats.h"
+#include "scheduler-helper.h"
 
 using namespace ns3;
 
 NS_LOG_COMPONENT_DEFINE ("BulkSendExample");
 
+// Packets handed to the sockets by the senders (like simulation 3)
+ns3::Time last_time_tx;
+uint64_t packet_count_tx = 0;
+uint64_t packet_size_tx = 0;
+void TxPacket(Ptr<const Packet> packet) {
+    last_time_tx = Simulator::Now();
+    packet_count_tx++;
+    packet_size_tx += packet->GetSize();
+}
+
+// Airtime accounting, the window is closed as soon as maxBytes have been received
+WifiAirtimeStats airtime_stats;
+WifiEnergyStats energy_stats;
+
+// Called once by the sink, as soon as maxBytes have been received
+void TransferComplete(uint64_t rx_bytes) {
+    airtime_stats.SetWindowEnd(Simulator::Now());
+    energy_stats.CloseWindow();
+}
+
 int
 main(int argc, char *argv[]) {
     // This activates packet logging to ascii and pcap files
@@ -71,11 +124,42 @@ main(int argc, char *argv[]) {
     uint32_t send_size = 1024;
     // We simulate a tcp connection (example's default). Can be changed to `ns3::UdpSocketFactory`.
     std::string socket_factory = "ns3::TcpSocketFactory";
-    // Wifi Rate - get those from src/wifi/model/wifi-phy.cc for IEEE802.11g
-    // Examples: ErpOfdmRate{48 36 48 18 12 9 6}Mbps
-    std::string wifi_transmission_mode = "ErpOfdmRate54Mbps";
+    // Wifi standard: g, n-2.4, n-5 or ac, channel width in MHz (0: default of the standard)
+    std::string standard = "g";
+    uint16_t channel_width = 0;
+    // Maximum A-MPDU and A-MSDU size in bytes (802.11n/ac only), 0 disables the aggregation
+    uint32_t max_ampdu = 65535;
+    uint32_t max_amsdu = 0;
+    // Rate control: minstrel or constant (using wifi_transmission_mode)
+    std::string rate_manager = "minstrel";
+    // Wifi Rate - get those from src/wifi/model/wifi-phy.cc
+    // Examples: ErpOfdmRate{48 36 48 18 12 9 6}Mbps (802.11g), HtMcs{0..7} (802.11n), VhtMcs{0..9} (802.11ac)
+    // Empty selects the fastest single stream rate of the standard.
+    std::string wifi_transmission_mode = "";
     // Distance between simulated nodes
     double distance = 5.0;
+    // Wifi PHY: yans or spectrum (MultiModelSpectrumChannel)
+    std::string phy = "yans";
+    // Account airtime per node using the wifi phy state traces
+    bool airtime = false;
+    // Install batteries and radio energy models; initial energy in J and supply voltage in V per node
+    bool energy = false;
+    double energy_initial = 10000.0;
+    double energy_voltage = 3.0;
+    // Number of parallel TCP connections maxBytes is striped across
+    uint32_t connections = 1;
+    // Event scheduler: heap, map (ns3's default), list or calendar
+    std::string scheduler = "map";
+    // Report the n event types which took most of the wall clock time (0: no profiling)
+    uint32_t profile = 0;
+    // TCP congestion control (newreno, westwood, westwoodplus, vegas, bic, hybla, highspeed, htcp, scalable, veno,
+    // yeah, illinois, ledbat, lp), options, maximum segment size and socket buffer sizes (defaults: ns3's)
+    std::string tcp_variant = "newreno";
+    bool sack = true;
+    bool window_scaling = true;
+    uint32_t tcp_segment_size = 536;
+    uint32_t snd_buf = 131072;
+    uint32_t rcv_buf = 131072;
 
     //
     // Allow the user to override any of the defaults at
@@ -87,10 +171,48 @@ main(int argc, char *argv[]) {
     cmd.AddValue("maxBytes", "Total number of bytes for application to send", maxBytes);
     cmd.AddValue("send_size", "Bytes sent per packet", send_size);
     cmd.AddValue("socket_factory", "Socket Factory to use. Default is ns3::TcpSocketFactory", socket_factory);
-    cmd.AddValue("wifi_transmission_mode", "WiFi transmission mode to use for 802.11g: ErpOfdmRate{48 36 48 18 12 9 6}Mbps", wifi_transmission_mode);
+    cmd.AddValue("standard", "Wifi standard: g, n-2.4, n-5 or ac", standard);
+    cmd.AddValue("channel_width", "Channel width in MHz (0: 20 MHz, 80 MHz for 802.11ac)", channel_width);
+    cmd.AddValue("max_ampdu", "Maximum A-MPDU size in bytes for 802.11n/ac (0 disables A-MPDU)", max_ampdu);
+    cmd.AddValue("max_amsdu", "Maximum A-MSDU size in bytes for 802.11n/ac (0 disables A-MSDU)", max_amsdu);
+    cmd.AddValue("rate_manager", "Rate control: minstrel or constant (uses wifi_transmission_mode)", rate_manager);
+    cmd.AddValue("wifi_transmission_mode", "WiFi transmission mode to use with --rate_manager=constant, e.g. ErpOfdmRate{54 48 36 18 12 9 6}Mbps, HtMcs7 or VhtMcs8", wifi_transmission_mode);
     cmd.AddValue("distance", "Distance between simulated nodes", distance);
+    cmd.AddValue("phy", "Wifi PHY: yans or spectrum (SpectrumWifiPhy, models inter-channel interference)", phy);
+    cmd.AddValue("airtime", "Report TX/RX/CCA busy/idle time per node and the channel utilisation", airtime);
+    cmd.AddValue("energy", "Report the energy consumed per node and per delivered bit", energy);
+    cmd.AddValue("energy_initial", "Energy stored in the battery of every node in J", energy_initial);
+    cmd.AddValue("energy_voltage", "Supply voltage of the batteries in V", energy_voltage);
+    cmd.AddValue("connections", "Number of parallel TCP connections maxBytes is striped across", connections);
+    cmd.AddValue("scheduler", "Event scheduler: heap, map, list or calendar", scheduler);
+    cmd.AddValue("profile", "Print the n event types which took most of the wall clock time (0: off)", profile);
+    cmd.AddValue("tcp_variant", "TCP congestion control: newreno, westwood, westwoodplus, vegas, bic, hybla, highspeed, htcp, scalable, veno, yeah, illinois, ledbat or lp", tcp_variant);
+    cmd.AddValue("sack", "Enable TCP selective acknowledgements", sack);
+    cmd.AddValue("window_scaling", "Enable the TCP window scale option", window_scaling);
+    cmd.AddValue("segment_size", "TCP maximum segment size in bytes", tcp_segment_size);
+    cmd.AddValue("snd_buf", "TCP send buffer size in bytes", snd_buf);
+    cmd.AddValue("rcv_buf", "TCP receive buffer size in bytes", rcv_buf);
     cmd.Parse(argc, argv);
 
+    // Must be set before the first TCP socket is created
+    TcpConfigHelper tcpConfig;
+    tcpConfig.SetVariant(tcp_variant);
+    tcpConfig.SetOptions(sack, window_scaling);
+    tcpConfig.SetSegmentSize(tcp_segment_size);
+    tcpConfig.SetBufferSizes(snd_buf, rcv_buf);
+    tcpConfig.Configure();
+
+    SchedulerHelper schedulerHelper;
+    schedulerHelper.SetScheduler(scheduler);
+    schedulerHelper.SetProfile(profile);
+    schedulerHelper.Configure();
+
+    WifiStandardHelper wifiStandard;
+    wifiStandard.SetStandard(standard);
+    wifiStandard.SetChannelWidth(channel_width);
+    wifiStandard.SetAggregation(max_ampdu, max_amsdu);
+    wifiStandard.SetRateManager(rate_manager, wifi_transmission_mode);
+
     //
     // Explicitly create the nodes required by the topology (shown above).
     //
@@ -109,11 +231,15 @@ main(int argc, char *argv[]) {
         wifi.EnableLogComponents();
     }
 
-    // Use 802.11g, like the specified TP Link Router
-    wifi.SetStandard(WIFI_PHY_STANDARD_80211g);
+    // Default: Use 802.11g, like the specified TP Link Router
+    wifiStandard.Configure(wifi);
 
-    YansWifiPhyHelper wifiPhy = YansWifiPhyHelper::Default();
-    wifiPhy.Set("ChannelWidth", UintegerValue(20));
+    if (phy != "yans" && phy != "spectrum") {
+        NS_FATAL_ERROR("Unknown PHY " << phy);
+    }
+    YansWifiPhyHelper yansPhy = YansWifiPhyHelper::Default();
+    SpectrumWifiPhyHelper spectrumPhy = SpectrumWifiPhyHelper::Default();
+    WifiPhyHelper &wifiPhy = (phy == "spectrum") ? static_cast<WifiPhyHelper &>(spectrumPhy) : yansPhy;
     wifiPhy.Set("TxGain", DoubleValue(1.0));
     wifiPhy.Set("RxGain", DoubleValue(1.0));
     wifiPhy.Set("TxPowerStart", DoubleValue(1.0));
@@ -127,22 +253,41 @@ main(int argc, char *argv[]) {
     // => This means we assume the scenario stated above!
     //
 
-    wifiChannel.AddPropagationLoss("ns3::ItuR1411LosPropagationLossModel", "Frequency", DoubleValue(2400.0 * 1e6));
+    wifiChannel.AddPropagationLoss("ns3::ItuR1411LosPropagationLossModel", "Frequency", DoubleValue(wifiStandard.GetFrequency()));
     // wifiChannel.AddPropagationLoss ("ns3::FixedRssLossModel","Rss",DoubleValue (-80));
-    wifiPhy.SetChannel(wifiChannel.Create());
+    yansPhy.SetChannel(wifiChannel.Create());
+
+    // The same propagation models on a spectrum channel, which delivers every signal as power spectral density
+    if (phy == "spectrum") {
+        Ptr<ItuR1411LosPropagationLossModel> loss = CreateObject<ItuR1411LosPropagationLossModel>();
+        loss->SetAttribute("Frequency", DoubleValue(wifiStandard.GetFrequency()));
+        Ptr<MultiModelSpectrumChannel> spectrumChannel = CreateObject<MultiModelSpectrumChannel>();
+        spectrumChannel->AddPropagationLossModel(loss);
+        spectrumChannel->SetPropagationDelayModel(CreateObject<ConstantSpeedPropagationDelayModel>());
+        spectrumPhy.SetChannel(spectrumChannel);
+    }
 
     ///
     // Cited from ConstantRateWifiManager class documentation:
     // "use constant rates for data and control transmissions
     //
     // This class uses always the same transmission rate for every packet sent."
+    // The remote station manager was already set by wifiStandard.Configure.
     //
 
-    wifi.SetRemoteStationManager("ns3::MinstrelWifiManager");
     WifiMacHelper wifiMac;
     wifiMac.SetType("ns3::AdhocWifiMac");
 
     NetDeviceContainer devices = wifi.Install(wifiPhy, wifiMac, nodes);
+    wifiStandard.ConfigureDevices(devices);
+
+    if (airtime) {
+        airtime_stats.Install(devices);
+    }
+
+    if (energy) {
+        energy_stats.Install(devices, energy_initial, energy_voltage);
+    }
 
     MobilityHelper mobility;
     Ptr<ListPositionAllocator> positionAlloc = CreateObject<ListPositionAllocator>();
@@ -183,19 +328,33 @@ main(int argc, char *argv[]) {
     source.SetAttribute("MaxBytes", UintegerValue(maxBytes));
     // Set the amount of data to send per packet
     source.SetAttribute("SendSize", UintegerValue(send_size));
+    // The UDP sender has no connections
+    if (socket_factory == "ns3::UdpSocketFactory") {
+        if (connections > 1) {
+            NS_FATAL_ERROR("Parallel connections are only supported for TCP");
+        }
+    } else {
+        source.SetAttribute("Connections", UintegerValue(connections));
+    }
     ApplicationContainer sourceApps = source.Install(nodes.Get(0));
+    sourceApps.Get(0)->TraceConnectWithoutContext("Tx", MakeCallback(&TxPacket));
     sourceApps.Start(Seconds(0.0));
     sourceApps.Stop(Seconds(10.0));
 
     //
-    // Create a PacketSinkApplication and install it on node 1
+    // Create a CountingSink and install it on node 1
     //
-    PacketSinkHelper sink(socket_factory,
-                          InetSocketAddress(Ipv4Address::GetAny(), port));
+    CountingSinkHelper sink(socket_factory,
+                            InetSocketAddress(Ipv4Address::GetAny(), port));
     ApplicationContainer sinkApps = sink.Install(nodes.Get(1));
     sinkApps.Start(Seconds(0.0));
     sinkApps.Stop(Seconds(10.0));
 
+    Ptr<CountingSink> sink1 = DynamicCast<CountingSink>(sinkApps.Get(0));
+    sink1->SetThresholdCallback(maxBytes, MakeCallback(&TransferComplete));
+    ConnectionStats connection_stats;
+    connection_stats.Install(sink1, Seconds(0.0));
+
     //
     // Set up tracing if enabled
     //
@@ -214,10 +373,41 @@ main(int argc, char *argv[]) {
     // to transmit inside the simulation. Using a 1Mbps link, this time increses to a little bit under 10s.
     // For every realisic scenario, 10s should be okay.
     Simulator::Stop(Seconds(10.0));
-    Simulator::Run();
+    schedulerHelper.Run();
+    Time simulation_end = Simulator::Now();
+    energy_stats.CloseWindow();
     Simulator::Destroy();
     NS_LOG_INFO("Done.");
 
-    Ptr<PacketSink> sink1 = DynamicCast<PacketSink>(sinkApps.Get(0));
-    std::cout << "Total Bytes Received: " << sink1->GetTotalRx() << std::endl;
+    Time last_time_rx = sink1->GetTotal().last;
+    std::cerr << "Total Bytes Received: " << sink1->GetTotalRx() << std::endl;
+    std::cerr << "Last packet received at: " << last_time_rx.GetMilliSeconds() << "ms" << std::endl;
+
+    std::cout << "{";
+    std::cout << "\"rx_bytes_application\":" << sink1->GetTotalRx() << ",";
+    std::cout << "\"rx_ms_last\":" << last_time_rx.GetMilliSeconds() << ",";
+    std::cout << "\"rx_ms_first\":" << sink1->GetTotal().first.GetMilliSeconds() << ",";
+    std::cout << "\"rx_count_packets\":" << sink1->GetTotal().rxPackets << ",";
+    std::cout << "\"rx_bytes_packets\":" << sink1->GetTotal().rxBytes << ",";
+    std::cout << "\"tx_count_packets\":" << packet_count_tx << ",";
+    std::cout << "\"tx_bytes_packets\":" << packet_size_tx << ",";
+    std::cout << "\"tx_ms_last\":" << last_time_tx.GetMilliSeconds() << ",";
+    std::cout << "\"phy\":\"" << phy << "\",";
+    std::cout << "\"wifi\":";
+    wifiStandard.PrintJson(std::cout);
+    std::cout << ",\"tcp\":";
+    tcpConfig.PrintJson(std::cout);
+    std::cout << ",\"connections\":";
+    connection_stats.PrintJson(std::cout);
+    std::cout << ",\"simulator\":";
+    schedulerHelper.PrintJson(std::cout);
+    if (airtime) {
+        std::cout << ",\"airtime\":";
+        airtime_stats.PrintJson(std::cout, simulation_end);
+    }
+    if (energy) {
+        std::cout << ",\"energy\":";
+        energy_stats.PrintJson(std::cout, sink1->GetTotalRx());
+    }
+    std::cout << "}";
 }
@@ -14,7 +14,7 @@
  * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
  */
 
-// Network topology
+// Network topology (default, see --topology for the multi channel and hybrid variants)
 //                              Wifi
 //          - distance -    - distance -   - distance -
 //       ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
@@ -22,6 +22,12 @@
 //                                                        
 //                          10.1.2.0/24                   
 //
+// --topology=hybrid --segments=2
+//              Wifi                                     Wifi
+//       ~~~~~~~~~~~~~~~~~~                       ~~~~~~~~~~~~~~~~~~
+//       r1              r2 -------------------- r3              r4
+//          10.3.1.0/24         p2p 10.4.1.0/24      10.3.2.0/24
+//
 // - Flow from n0 to n1 using BulkSendApplication.
 // - Tracing of queues and packet receptions to file "bulk-send.tr"
 //   and pcap tracing available when tracing is turned on.
@@ -40,6 +46,87 @@
 // When specifying --olsrperf the olsr routing tables are written to a text file called olsr.txt and the simulation is terminated.
 // When using static routing (default) it sets up routing tables such that r1 -> r2 -> r3 -> r4.
 // Using the switch --ns3routing direct routes are setup (r1 -> r4)
+// Using --routing={static,ns3,olsr,aodv,dsdv,dsr} any of the routing protocols can be chosen (--olsr and --ns3routing
+// are shortcuts for --routing=olsr and --routing=ns3). The packets sent by the routing protocol are counted and reported
+// as "routing" inside the JSON output, together with the delay until the first packet arrived at the sink.
+// Using --olsr_hello, --olsr_tc, --olsr_mid and --olsr_hna (ms) the OLSR message intervals can be set, using
+// --olsr_willingness={never,low,default,high,always} the willingness of the routers to forward. The first time every
+// router has a route to the sink (and the sink one back to the source), the number of times one of these routes was
+// lost afterwards and the longest time until it was back (or the end, if it is still lost) are reported as "olsr",
+// with the control bytes per second.
+// Using --frame_stats every frame transmitted by a wifi phy is classified (OLSR control, other routing control,
+// TCP data, TCP ACK, UDP data, ARP, MAC control) and frames, bytes and airtime are reported per class as "frames".
+// Using the switch --airtime the time every node spends transmitting, receiving, sensing a busy channel and idling
+// is accounted from the YansWifiPhy state traces and reported within the JSON output. The measurement window starts
+// with the BulkSender (start_at) and ends as soon as maxBytes have been received. The radios of a relay (multichannel)
+// are added up per node, the channel utilisation is reported per channel number ("channels").
+// Using --mobility=waypoint the routers move according to the random waypoint model inside the area spanned by the
+// chain, --mobility=trace reads their movements from an ns-2 mobility trace file (--mobility_trace).
+// Both models only store the current velocity and compute positions on demand, so position lookups on the
+// propagation path stay cheap. Course changes and changes of the next hop towards the sink (OLSR) are reported.
+// Using --replay=<file> the BulkSender replays the packet sizes and inter-arrival times of a captured trace
+// (see custom-bulk-send-application.h for the format) over TCP or UDP instead of sending as fast as possible.
+// Using --nodes=<n> any number of routers can be simulated. They are placed in a line (--layout=line, default) or on a
+// square lattice (--layout=grid), both with a spacing of distance. Static routing needs the line layout and forwards
+// hop by hop from the first to the last router; the first router is always the source, the last one the sink.
+// Using --channel=grid the routers are attached to a GridWifiChannel instead of a YansWifiChannel. It only schedules
+// receptions on PHYs in reach of the sender, which keeps large topologies (100+ nodes) fast. The number of scheduled
+// and culled receptions is reported as "channel".
+// Using --phy=spectrum the routers get a SpectrumWifiPhy on a MultiModelSpectrumChannel (same propagation models)
+// instead of a YansWifiPhy. It models the power spectral density of every signal, so adjacent and overlapping
+// channels interfere, at the price of a slower simulation. The PHY is reported as "phy", its cost in "simulator".
+// Using --standard={g,n-2.4,n-5,ac} 802.11n/ac can be simulated instead of 802.11g, with A-MPDU/A-MSDU aggregation
+// (--max_ampdu, --max_amsdu) and wider channels (--channel_width). --rate_manager=constant uses wifi_transmission_mode
+// for all data frames instead of Minstrel (MinstrelHt for 802.11n/ac). The configuration is reported as "wifi".
+// Using --topology=multichannel every hop of the chain gets an ad-hoc network of its own, tuned to one of
+// --radio_channels non-overlapping channels in turn, so every relay has two wifi interfaces (one per neighbour) and
+// neighbouring hops can transmit at the same time. Hop i uses the subnet 10.2.(i+1).0/24. This works with static,
+// OLSR, AODV and DSDV routing on the line layout.
+// Using --topology=hybrid the chain is split into --segments wifi segments of equal size (alternating channels as
+// above), the last router of a segment is connected to the first router of the next one by a point-to-point backhaul
+// link (--backhaul_rate, --backhaul_delay). Segment k uses 10.3.(k+1).0/24, backhaul link k 10.4.(k+1).0/24.
+// Load, drops and queue occupancy of the backhaul links are reported as "backhaul".
+// Using --rts_cts_threshold=<bytes> frames larger than the threshold are protected by RTS/CTS (0: all frames).
+// Using --hidden=<ratio> the routers are placed at this fraction of the carrier sense range of a transmission (instead
+// of --distance). Above 0.5 the neighbours of every relay can not sense each other (hidden terminals), but they must
+// still decode the relay: the ratio may be at most receive range / carrier sense range (both are printed), else the
+// simulation stops. At the default height of 100m no ratio above 0.5 is possible, use e.g. --height=1.5 --hidden=0.55.
+// Using --collisions undecodable/dropped frames, failed RTS and data transmissions (retransmissions) are reported per
+// node as "collisions", inside the same window as the airtime.
+// Using --queue_disc={pfifo_fast,codel,fq_codel,pie} the queue disc of every router interface can be chosen
+// (--queue_limit sets its size, e.g. 100p, --device_queue the size of the backhaul device queues below it).
+// Packets dropped, maximum occupancy and sojourn time of every queue disc are reported as "queue_discs".
+// Using --probe_interval=<ms> the source pings the sink next to the transfer, the RTTs are reported as "probe".
+// Using --tcp_variant={newreno,westwood,westwoodplus,vegas,bic,hybla,highspeed,...} the TCP congestion control can be
+// chosen, --sack, --window_scaling, --segment_size, --snd_buf and --rcv_buf set the socket options. The TCP
+// configuration is reported as "tcp".
+// Using --connections=<k> the BulkSender opens k parallel TCP connections and stripes maxBytes across them. Bytes,
+// throughput and completion time of every connection and of all of them together are reported as "connections".
+// Using --workload=request_response the source issues request/response transactions instead of the bulk transfer:
+// --concurrency connections with one outstanding transaction each, --transactions in total. Requests are
+// --request_size bytes (uniformly up to --request_size_max if set), responses --response_size bytes. Transactions per
+// second, latency percentiles and the delivered bytes are reported as "request_response". The measurement windows
+// (airtime, energy, collisions, ...) end as soon as the last transaction has completed.
+// Using --scheduler={heap,map,list,calendar} the event scheduler can be chosen. Events executed, wall clock time
+// and events per second of the run are reported as "simulator".
+// Using --profile=<n> the wall clock time of the run is accounted to the types of the events executed (the class and
+// signature of the scheduled member function, or the signature of the scheduled function, and the bound argument
+// types; timers of the same class and signature share a row), the top n are printed to stderr and reported as
+// "profile" inside "simulator".
+// Using --memory the heap memory allocated while creating the nodes, installing wifi, the internet stack, addresses
+// and routes, the applications and while running is reported as "memory", with the number of nodes, devices,
+// applications and aggregated objects (also per type). The phases stand in for components, the allocator can not
+// attribute bytes to objects. Using --lean the per node footprint is reduced: no IPv6 stack, wifi MAC
+// queues and queue discs bounded to 100 packets (unless --queue_limit is given); --tracing, which needs packet
+// metadata, can not be combined with it.
+// Using --energy every node gets a battery (--energy_initial J at --energy_voltage V) its wifi radios draw from
+// (WifiRadioEnergyModel). The energy consumed per node inside the measurement window and the energy per delivered
+// bit are reported as "energy". With --workload=request_response the request and response bytes count as delivered.
+// Using --payload_file=<file> the BulkSender sends the contents of this file (memory-mapped) over a single TCP
+// connection instead of zeros, maxBytes becomes the size of the file. The sink checksums the received byte stream;
+// size, checksums, whether they match and the completion time are reported as "payload".
+// The receiver is a CountingSink instead of ns3's PacketSink: it counts bytes, packets and arrival times per flow
+// itself and calls back once when maxBytes have arrived (closing the measurement windows and stopping UDP senders).
 // The program proceeds by sending as many TCP or UDP packets with a configurable size (send_size) as it can,
 // until it has sent maxBytes bytes.
 
@@ -47,22 +134,61 @@
 // Set all variables specified on the practice sheet and use MinstrelWifiManager
 // Set up more nodes, subnets and routing between them
 
+#include <algorithm>
+#include <cmath>
 #include <string>
 #include <fstream>
+#include <sstream>
+#include <vector>
+#include <stdint.h>
+#include <sys/stat.h>
 #include "ns3/core-module.h"
 #include "ns3/internet-module.h"
 #include "ns3/point-to-point-module.h"
+#include "ns3/traffic-control-module.h"
 #include "ns3/applications-module.h"
 #include "ns3/network-module.h"
-#include "ns3/packet-sink.h"
 #include "ns3/yans-wifi-helper.h"
 #include "ns3/mobility-helper.h"
 #include "ns3/ipv4-address-helper.h"
 #include "ns3/yans-wifi-channel.h"
+#include "ns3/yans-wifi-phy.h"
+#include "ns3/nist-error-rate-model.h"
+#include "ns3/wifi-tx-vector.h"
+#include "ns3/wifi-mode.h"
+#include "ns3/spectrum-wifi-helper.h"
+#include "ns3/multi-model-spectrum-channel.h"
+#include "ns3/itu-r-1411-los-propagation-model.h"
+#include "ns3/propagation-delay-model.h"
 #include "ns3/mobility-model.h"
 #include "ns3/olsr-helper.h"
+#include "ns3/olsr-routing-protocol.h"
+#include "ns3/ns2-mobility-helper.h"
+#include "ns3/aodv-helper.h"
+#include "ns3/dsdv-helper.h"
+#include "ns3/dsr-helper.h"
+#include "ns3/dsr-main-helper.h"
 #include "custom-bulk-send-helper.h"
 #include "custom-bulk-send-application.h"
+#include "tcp-bulk-send-application.h"
+#include "wifi-airtime-stats.h"
+#include "wifi-energy-stats.h"
+#include "routing-overhead-stats.h"
+#include "wifi-frame-stats.h"
+#include "grid-wifi-helper.h"
+#include "wifi-standard-helper.h"
+#include "p2p-link-stats.h"
+#include "wifi-collision-stats.h"
+#include "queue-disc-stats.h"
+#include "latency-probe.h"
+#include "tcp-config-helper.h"
+#include "counting-sink-helper.h"
+#include "connection-stats.h"
+#include "payload-checksum.h"
+#include "scheduler-helper.h"
+#include "memory-report.h"
+#include "request-response-helper.h"
+#include "request-response-client.h"
 
 
 using namespace ns3;
@@ -80,14 +206,109 @@ void TxPacket(Ptr<const Packet> packet) {
     packet_size_tx += packet->GetSize();
 }
 
-ns3::Time last_time_rx;
-uint64_t packet_count_rx = 0;
-uint64_t packet_size_rx = 0;
-void RecvPacket(Ptr<const Packet> packet, const Address &address) {
-    last_time_rx = Simulator::Now();
-    packet_count_rx++;
-    packet_size_rx += packet->GetSize();
-    bulk_send->AnnouncePacketsReceived(packet_size_rx);
+// One hop of the router chain, connecting router i (left) with router i + 1 (right)
+struct Hop {
+    Ptr<NetDevice> leftDevice;
+    Ipv4Address leftAddress;
+    Ptr<NetDevice> rightDevice;
+    Ipv4Address rightAddress;
+};
+
+Hop MakeHop(const NetDeviceContainer &devices, const Ipv4InterfaceContainer &addresses, uint32_t left, uint32_t right) {
+    Hop hop;
+    hop.leftDevice = devices.Get(left);
+    hop.leftAddress = addresses.GetAddress(left);
+    hop.rightDevice = devices.Get(right);
+    hop.rightAddress = addresses.GetAddress(right);
+    return hop;
+}
+
+// Airtime accounting, the window is closed as soon as maxBytes have been received
+WifiAirtimeStats airtime_stats;
+WifiEnergyStats energy_stats;
+// Backhaul link and collision accounting, using the same window
+PointToPointLinkStats backhaul_stats;
+WifiCollisionStats collision_stats;
+QueueDiscStats queue_disc_stats;
+
+// Mobility: Count course changes of all nodes and changes of the next hop towards the sink
+uint64_t course_changes = 0;
+uint64_t route_changes = 0;
+ns3::Time route_changes_from;
+Ipv4Address route_sink;
+std::vector<Ipv4Address> route_next_hops;
+// OLSR convergence: Routers whose route to the sink (the sink: back to the source) is missing
+Ipv4Address route_source;
+uint32_t route_sink_node;
+std::vector<bool> route_complete;
+uint32_t routes_missing = 0;
+ns3::Time route_converged = ns3::Seconds(-1);
+ns3::Time route_lost;
+uint64_t route_outages = 0;
+ns3::Time route_outage_max;
+
+void CourseChanged(Ptr<const MobilityModel> model) {
+    course_changes++;
+}
+
+void OlsrRoutingTableChanged(uint32_t node, uint32_t size) {
+    Ptr<olsr::RoutingProtocol> agent = NodeList::GetNode(node)->GetObject<olsr::RoutingProtocol>();
+    Ipv4Address next_hop;
+    Ipv4Address target = node == route_sink_node ? route_source : route_sink;
+    bool complete = false;
+    std::vector<olsr::RoutingTableEntry> entries = agent->GetRoutingTableEntries();
+    for (std::vector<olsr::RoutingTableEntry>::const_iterator i = entries.begin(); i != entries.end(); ++i) {
+        if (i->destAddr == route_sink) {
+            next_hop = i->nextAddr;
+        }
+        if (i->destAddr == target) {
+            complete = true;
+        }
+    }
+    // Converged as soon as no router misses its route. Once converged, every loss of a route starts an outage
+    // which lasts until all routes are back.
+    if (complete != route_complete[node]) {
+        route_complete[node] = complete;
+        if (complete) {
+            routes_missing--;
+            if (routes_missing == 0) {
+                if (route_converged.IsNegative()) {
+                    route_converged = Simulator::Now();
+                } else {
+                    route_outage_max = std::max(route_outage_max, Simulator::Now() - route_lost);
+                }
+            }
+        } else {
+            if (routes_missing == 0 && !route_converged.IsNegative()) {
+                route_outages++;
+                route_lost = Simulator::Now();
+            }
+            routes_missing++;
+        }
+    }
+    // OLSR recomputes its table whenever its link state changes. Only count if the route to the sink did change
+    // while the transfer is running, the initial route setup is not of interest.
+    if (next_hop != route_next_hops[node]) {
+        if (Simulator::Now() >= route_changes_from) {
+            route_changes++;
+        }
+        route_next_hops[node] = next_hop;
+    }
+}
+
+// Called once by the sink, as soon as maxBytes have been received (request/response: by the client, as soon as the
+// last transaction has completed)
+void TransferComplete(uint64_t rx_bytes) {
+    Time now = Simulator::Now();
+    // UDP: The sender does not know when to stop otherwise
+    if (bulk_send) {
+        bulk_send->AnnouncePacketsReceived(rx_bytes);
+    }
+    airtime_stats.SetWindowEnd(now);
+    energy_stats.CloseWindow();
+    backhaul_stats.SetWindowEnd(now);
+    collision_stats.SetWindowEnd(now);
+    queue_disc_stats.SetWindowEnd(now);
 }
 
 int
@@ -96,6 +317,8 @@ main(int argc, char *argv[]) {
     bool tracing = false;
     // This activates verbose wifi logging
     bool logging = false;
+    // Routing protocol: static, ns3, olsr, aodv, dsdv or dsr
+    std::string routing = "static";
     // Use OLSR for wifi routing
     bool olsr = false;
     // Use static ns3 routing
@@ -108,15 +331,109 @@ main(int argc, char *argv[]) {
     std::string socket_factory = "ns3::TcpSocketFactory";
     // Distance between simulated nodes
     double distance = 50.0;
+    // Number of routers and their placement: line or grid
+    uint32_t nodes = 4;
+    std::string layout = "line";
+    // Wifi channel: yans or grid (spatially culled)
+    std::string channel = "yans";
+    // Wifi PHY: yans or spectrum (MultiModelSpectrumChannel)
+    std::string phy = "yans";
+    // Topology: single (all routers share one channel), multichannel (one channel per hop, alternating)
+    // or hybrid (wifi segments connected by point-to-point backhaul links)
+    std::string topology = "single";
+    uint32_t radio_channels = 2;
+    uint32_t segments = 2;
+    // Backhaul links, the defaults match simulation 1
+    std::string backhaul_rate = "100Mbps";
+    std::string backhaul_delay = "5ms";
+
+    // Queue disc on every router interface: pfifo_fast (ns3's default), codel, fq_codel or pie, and its size
+    std::string queue_disc = "pfifo_fast";
+    std::string queue_limit = "";
+    // Size of the backhaul device queues below the queue discs (empty: ns3's default of 100 packets)
+    std::string device_queue = "";
+    // Interval of the latency probe in ms (0 disables it)
+    uint32_t probe_interval = 0;
+    // Wifi standard: g, n-2.4, n-5 or ac, channel width in MHz (0: default of the standard)
+    std::string standard = "g";
+    uint16_t channel_width = 0;
+    // Maximum A-MPDU and A-MSDU size in bytes (802.11n/ac only), 0 disables the aggregation
+    uint32_t max_ampdu = 65535;
+    uint32_t max_amsdu = 0;
+    // Rate control: minstrel or constant (using wifi_transmission_mode, empty: fastest single stream rate)
+    std::string rate_manager = "minstrel";
+    std::string wifi_transmission_mode = "";
 
     // Height of simulated Wifi nodes in m
     double height = 100.0;
+    // Place the routers at this fraction of the detection range instead (0: use distance)
+    double hidden = 0.0;
+
+    // Transmission power in dBm and antenna gain in dB of all routers
+    double tx_power = 1.0;
+    double antenna_gain = 1.0;
+    // RTS/CTS protects frames larger than this (in bytes), the default disables it
+    uint32_t rts_cts_threshold = 65535;
+    // Count collisions and retransmissions per node
+    bool collisions = false;
 
     uint32_t udp_interval = 10;
     uint32_t udp_count = 100;
     uint32_t start_at = 10260;
 
     bool olsr_perf = false;
+    // OLSR message intervals in ms and willingness to forward (never, low, default, high, always); ns3's defaults
+    uint32_t olsr_hello = 2000;
+    uint32_t olsr_tc = 5000;
+    uint32_t olsr_mid = 5000;
+    uint32_t olsr_hna = 5000;
+    std::string olsr_willingness = "default";
+
+    // Account airtime per node using the wifi phy state traces
+    bool airtime = false;
+    // Classify all transmitted frames by protocol
+    bool frame_stats = false;
+
+    // Router mobility: static, waypoint (random waypoint) or trace (ns-2 mobility trace file)
+    std::string mobility_mode = "static";
+    std::string mobility_trace;
+    // Random waypoint: Maximum speed in m/s and pause time in s
+    double speed = 2.0;
+    double pause = 2.0;
+
+    // Trace file to replay instead of the bulk transfer
+    std::string replay;
+    // Install batteries and radio energy models; initial energy in J and supply voltage in V per node
+    bool energy = false;
+    double energy_initial = 10000.0;
+    double energy_voltage = 3.0;
+    // Send the contents of this file instead of zero-filled packets
+    std::string payload_file;
+    // Number of parallel TCP connections maxBytes is striped across
+    uint32_t connections = 1;
+    // Workload: bulk (CustomBulkSendApplication) or request_response (closed loop transactions)
+    std::string workload = "bulk";
+    uint32_t concurrency = 1;
+    uint32_t transactions = 1000;
+    uint32_t request_size = 100;
+    uint32_t request_size_max = 0;
+    uint32_t response_size = 1000;
+    // Event scheduler: heap, map (ns3's default), list or calendar
+    std::string scheduler = "map";
+    // Report the heap memory allocated per build phase
+    bool memory = false;
+    // Reduce the memory footprint per node
+    bool lean = false;
+    // Report the n event types which took most of the wall clock time (0: no profiling)
+    uint32_t profile = 0;
+    // TCP congestion control (newreno, westwood, westwoodplus, vegas, bic, hybla, highspeed, htcp, scalable, veno,
+    // yeah, illinois, ledbat, lp), options, maximum segment size and socket buffer sizes (defaults: ns3's)
+    std::string tcp_variant = "newreno";
+    bool sack = true;
+    bool window_scaling = true;
+    uint32_t tcp_segment_size = 536;
+    uint32_t snd_buf = 131072;
+    uint32_t rcv_buf = 131072;
 
 
     //
@@ -128,24 +445,235 @@ main(int argc, char *argv[]) {
     cmd.AddValue("logging", "Flag to enable/disable logging", logging);
     cmd.AddValue("olsr", "Use OLSR for wifi routing", olsr);
     cmd.AddValue("ns3routing", "Use static ns3 routing", ns3routing);
+    cmd.AddValue("routing", "Routing protocol: static, ns3, olsr, aodv, dsdv or dsr", routing);
     cmd.AddValue("olsrperf", "OLSR performance measurement", olsr_perf);
+    cmd.AddValue("olsr_hello", "OLSR HELLO interval in ms", olsr_hello);
+    cmd.AddValue("olsr_tc", "OLSR TC (topology control) interval in ms", olsr_tc);
+    cmd.AddValue("olsr_mid", "OLSR MID (multiple interface declaration) interval in ms", olsr_mid);
+    cmd.AddValue("olsr_hna", "OLSR HNA (host and network association) interval in ms", olsr_hna);
+    cmd.AddValue("olsr_willingness", "OLSR willingness to forward: never, low, default, high or always", olsr_willingness);
     cmd.AddValue("maxBytes", "Total number of bytes for application to send", maxBytes);
     cmd.AddValue("send_size", "Bytes sent per packet", send_size);
     cmd.AddValue("socket_factory", "Socket Factory to use. Default is ns3::TcpSocketFactory", socket_factory);
     cmd.AddValue("distance", "Distance between simulated nodes", distance);
     cmd.AddValue("height", "Height of Wifi Nodes", height);
+    cmd.AddValue("hidden", "Place the routers at this fraction of the carrier sense range (0.5 < x <= receive range / carrier sense range: hidden terminals)", hidden);
+    cmd.AddValue("rts_cts_threshold", "Protect frames larger than this many bytes by RTS/CTS (0: all, 65535: none)", rts_cts_threshold);
+    cmd.AddValue("collisions", "Report collisions and retransmissions per node", collisions);
+    cmd.AddValue("nodes", "Number of routers", nodes);
+    cmd.AddValue("layout", "Placement of the routers: line or grid", layout);
+    cmd.AddValue("channel", "Wifi channel: yans or grid (only delivers frames to PHYs in reach)", channel);
+    cmd.AddValue("phy", "Wifi PHY: yans or spectrum (SpectrumWifiPhy, models inter-channel interference)", phy);
+    cmd.AddValue("topology", "single (one shared channel), multichannel (two radios per relay, one channel per hop) or hybrid (wifi segments and p2p backhaul)", topology);
+    cmd.AddValue("radio_channels", "Number of non-overlapping channels the hops (segments) alternate between", radio_channels);
+    cmd.AddValue("segments", "Number of wifi segments (hybrid)", segments);
+    cmd.AddValue("backhaul_rate", "Data rate of the point-to-point backhaul links (hybrid)", backhaul_rate);
+    cmd.AddValue("backhaul_delay", "Delay of the point-to-point backhaul links (hybrid)", backhaul_delay);
+    cmd.AddValue("queue_disc", "Queue disc: pfifo_fast, codel, fq_codel or pie", queue_disc);
+    cmd.AddValue("queue_limit", "Maximum size of the queue discs, e.g. 100p (empty: default of the queue disc)", queue_limit);
+    cmd.AddValue("device_queue", "Maximum size of the backhaul device queues, e.g. 1p (empty: 100p)", device_queue);
+    cmd.AddValue("probe_interval", "Send a ping every probe_interval ms next to the transfer (0: off)", probe_interval);
+    cmd.AddValue("standard", "Wifi standard: g, n-2.4, n-5 or ac", standard);
+    cmd.AddValue("channel_width", "Channel width in MHz (0: 20 MHz, 80 MHz for 802.11ac)", channel_width);
+    cmd.AddValue("max_ampdu", "Maximum A-MPDU size in bytes for 802.11n/ac (0 disables A-MPDU)", max_ampdu);
+    cmd.AddValue("max_amsdu", "Maximum A-MSDU size in bytes for 802.11n/ac (0 disables A-MSDU)", max_amsdu);
+    cmd.AddValue("rate_manager", "Rate control: minstrel or constant (uses wifi_transmission_mode)", rate_manager);
+    cmd.AddValue("wifi_transmission_mode", "WiFi transmission mode to use with --rate_manager=constant, e.g. ErpOfdmRate54Mbps, HtMcs7 or VhtMcs8", wifi_transmission_mode);
     cmd.AddValue("udp_interval", "Interval in which UDP packets get sent", udp_interval);
     cmd.AddValue("udp_count", "How many UDP packets get sent per interval", udp_count);
     cmd.AddValue("start_at", "At which time (ms) the BulkSender shall start sending", start_at);
+    cmd.AddValue("airtime", "Report TX/RX/CCA busy/idle time per node and the channel utilisation", airtime);
+    cmd.AddValue("frame_stats", "Report frames, bytes and airtime of transmitted frames per protocol", frame_stats);
+    cmd.AddValue("mobility", "Router mobility: static, waypoint or trace", mobility_mode);
+    cmd.AddValue("mobility_trace", "ns-2 mobility trace file to use with --mobility=trace", mobility_trace);
+    cmd.AddValue("speed", "Random waypoint: Maximum speed of the routers (m/s)", speed);
+    cmd.AddValue("pause", "Random waypoint: Pause time at each waypoint (s)", pause);
+    cmd.AddValue("replay", "Replay packet sizes and inter-arrival times from this trace file", replay);
+    cmd.AddValue("energy", "Report the energy consumed per node and per delivered bit", energy);
+    cmd.AddValue("energy_initial", "Energy stored in the battery of every node in J", energy_initial);
+    cmd.AddValue("energy_voltage", "Supply voltage of the batteries in V", energy_voltage);
+    cmd.AddValue("payload_file", "Send the contents of this file over TCP and verify its checksum at the sink", payload_file);
+    cmd.AddValue("connections", "Number of parallel TCP connections maxBytes is striped across", connections);
+    cmd.AddValue("workload", "Workload: bulk or request_response", workload);
+    cmd.AddValue("concurrency", "Request/response: Number of outstanding transactions (connections)", concurrency);
+    cmd.AddValue("transactions", "Request/response: Number of transactions", transactions);
+    cmd.AddValue("request_size", "Request/response: Size of the requests in bytes", request_size);
+    cmd.AddValue("request_size_max", "Request/response: Draw the request size uniformly up to this size (0: fixed size)", request_size_max);
+    cmd.AddValue("response_size", "Request/response: Size of the responses in bytes", response_size);
+    cmd.AddValue("scheduler", "Event scheduler: heap, map, list or calendar", scheduler);
+    cmd.AddValue("memory", "Report the heap memory allocated per build phase", memory);
+    cmd.AddValue("lean", "Reduce the memory footprint: no IPv6, bounded MAC queues and queue discs", lean);
+    cmd.AddValue("profile", "Print the n event types which took most of the wall clock time (0: off)", profile);
+    cmd.AddValue("tcp_variant", "TCP congestion control: newreno, westwood, westwoodplus, vegas, bic, hybla, highspeed, htcp, scalable, veno, yeah, illinois, ledbat or lp", tcp_variant);
+    cmd.AddValue("sack", "Enable TCP selective acknowledgements", sack);
+    cmd.AddValue("window_scaling", "Enable the TCP window scale option", window_scaling);
+    cmd.AddValue("segment_size", "TCP maximum segment size in bytes", tcp_segment_size);
+    cmd.AddValue("snd_buf", "TCP send buffer size in bytes", snd_buf);
+    cmd.AddValue("rcv_buf", "TCP receive buffer size in bytes", rcv_buf);
     cmd.Parse(argc, argv);
 
+    // Must be set before the first TCP socket is created
+    TcpConfigHelper tcpConfig;
+    tcpConfig.SetVariant(tcp_variant);
+    tcpConfig.SetOptions(sack, window_scaling);
+    tcpConfig.SetSegmentSize(tcp_segment_size);
+    tcpConfig.SetBufferSizes(snd_buf, rcv_buf);
+    tcpConfig.Configure();
+
+    SchedulerHelper schedulerHelper;
+    schedulerHelper.SetScheduler(scheduler);
+    schedulerHelper.SetProfile(profile);
+    schedulerHelper.Configure();
+
+    MemoryReport memory_report;
+    if (lean) {
+        if (tracing) {
+            NS_FATAL_ERROR("--lean can not be combined with --tracing, which enables packet metadata");
+        }
+        // ns3's defaults are 500 packets per wifi MAC queue and 1000 packets per pfifo_fast queue disc
+        Config::SetDefault("ns3::WifiMacQueue::MaxSize", QueueSizeValue(QueueSize("100p")));
+        if (queue_limit.empty()) {
+            queue_limit = "100p";
+        }
+    }
+
+    if (!payload_file.empty()) {
+        if (socket_factory != "ns3::TcpSocketFactory" || connections != 1 || !replay.empty() || workload != "bulk") {
+            NS_FATAL_ERROR("--payload_file needs a bulk transfer over a single TCP connection");
+        }
+        struct stat payload_stat;
+        if (stat(payload_file.c_str(), &payload_stat) == -1 || payload_stat.st_size == 0) {
+            NS_FATAL_ERROR("Unable to read payload file " << payload_file);
+        }
+        if ((uint64_t) payload_stat.st_size > UINT32_MAX) {
+            NS_FATAL_ERROR("Payload file " << payload_file << " is larger than 4 GiB");
+        }
+        // The whole file is transferred
+        maxBytes = payload_stat.st_size;
+    }
+
+    if (olsr) {
+        routing = "olsr";
+    } else if (ns3routing) {
+        routing = "ns3";
+    }
+    if (routing != "static" && routing != "ns3" && routing != "olsr" &&
+        routing != "aodv" && routing != "dsdv" && routing != "dsr") {
+        NS_FATAL_ERROR("Unknown routing protocol " << routing);
+    }
+    if (olsr_hello == 0 || olsr_tc == 0 || olsr_mid == 0 || olsr_hna == 0) {
+        NS_FATAL_ERROR("The OLSR intervals must be positive");
+    }
+    if (olsr_willingness != "never" && olsr_willingness != "low" && olsr_willingness != "default" &&
+        olsr_willingness != "high" && olsr_willingness != "always") {
+        NS_FATAL_ERROR("Unknown OLSR willingness " << olsr_willingness);
+    }
+    if (nodes < 2) {
+        NS_FATAL_ERROR("At least 2 routers are needed");
+    }
+    if (layout != "line" && layout != "grid") {
+        NS_FATAL_ERROR("Unknown layout " << layout);
+    }
+    if (layout != "line" && routing == "static") {
+        NS_FATAL_ERROR("Static routing needs --layout=line");
+    }
+    if (channel != "yans" && channel != "grid") {
+        NS_FATAL_ERROR("Unknown channel " << channel);
+    }
+    if (phy != "yans" && phy != "spectrum") {
+        NS_FATAL_ERROR("Unknown PHY " << phy);
+    }
+    if (phy == "spectrum" && channel == "grid") {
+        NS_FATAL_ERROR("--phy=spectrum brings its own channel and can not be combined with --channel=grid");
+    }
+    std::string queue_disc_type;
+    if (queue_disc == "pfifo_fast") {
+        queue_disc_type = "ns3::PfifoFastQueueDisc";
+    } else if (queue_disc == "codel") {
+        queue_disc_type = "ns3::CoDelQueueDisc";
+    } else if (queue_disc == "fq_codel") {
+        queue_disc_type = "ns3::FqCoDelQueueDisc";
+    } else if (queue_disc == "pie") {
+        queue_disc_type = "ns3::PieQueueDisc";
+    } else {
+        NS_FATAL_ERROR("Unknown queue disc " << queue_disc);
+    }
+    if (workload != "bulk" && workload != "request_response") {
+        NS_FATAL_ERROR("Unknown workload " << workload);
+    }
+    if (topology != "single" && topology != "multichannel" && topology != "hybrid") {
+        NS_FATAL_ERROR("Unknown topology " << topology);
+    }
+    if (topology != "single" && (layout != "line" || routing == "ns3" || routing == "dsr" || radio_channels == 0)) {
+        NS_FATAL_ERROR("--topology=" << topology << " needs --layout=line, at least one channel and static, olsr, aodv or dsdv routing");
+    }
+    if (topology == "hybrid" && (segments == 0 || nodes % segments != 0 || nodes / segments < 2)) {
+        NS_FATAL_ERROR("--topology=hybrid needs the routers to be split into segments of at least 2 routers each");
+    }
+
+    WifiStandardHelper wifiStandard;
+    wifiStandard.SetStandard(standard);
+    wifiStandard.SetChannelWidth(channel_width);
+    wifiStandard.SetAggregation(max_ampdu, max_amsdu);
+    wifiStandard.SetRateManager(rate_manager, wifi_transmission_mode);
+    wifiStandard.SetRtsCtsThreshold(rts_cts_threshold);
+
+    if (hidden > 0.0) {
+        //
+        // Hidden terminals: A router must decode its neighbours, but the routers two hops away must not detect its
+        // transmissions, i.e. receive them below the CCA mode 1 threshold of the PHY (-99 dBm, the carrier sense
+        // range). Decoding needs the energy detection threshold (-96 dBm) and the SNR at which the most robust mode
+        // of the standard reaches a bit error rate of 1e-5 above the noise floor (the receive range). So the routers
+        // must be more than half the carrier sense range, but at most the receive range apart.
+        //
+        Ptr<YansWifiPhy> defaultPhy = CreateObject<YansWifiPhy>();
+        DoubleValue noiseFigure;
+        defaultPhy->GetAttribute("RxNoiseFigure", noiseFigure);
+        WifiTxVector txVector;
+        txVector.SetMode(WifiMode(wifiStandard.GetControlMode()));
+        txVector.SetChannelWidth(wifiStandard.GetChannelWidth());
+        txVector.SetNss(1);
+        double snr = 10 * std::log10(CreateObject<NistErrorRateModel>()->CalculateSnr(txVector, 1e-5));
+        // Thermal noise (-174 dBm/Hz) over the channel width, raised by the noise figure of the receiver
+        double noiseFloor = -174.0 + 10 * std::log10(wifiStandard.GetChannelWidth() * 1e6) + noiseFigure.Get();
+        double csThreshold = defaultPhy->GetCcaMode1Threshold() - antenna_gain;
+        double rxThreshold = std::max(defaultPhy->GetEdThreshold(), noiseFloor + snr) - antenna_gain;
+
+        Ptr<ItuR1411LosPropagationLossModel> loss = CreateObject<ItuR1411LosPropagationLossModel>();
+        loss->SetAttribute("Frequency", DoubleValue(wifiStandard.GetFrequency()));
+        double csRange = GridWifiChannel::GetRange(loss, tx_power + antenna_gain, csThreshold, height, height);
+        double rxRange = GridWifiChannel::GetRange(loss, tx_power + antenna_gain, rxThreshold, height, height);
+        distance = hidden * csRange;
+        std::cerr << "Carrier sense range is " << csRange << "m, receive range is " << rxRange << "m, routers are "
+                  << distance << "m apart" << std::endl;
+        if (hidden > 0.5 && 2 * rxRange <= csRange) {
+            NS_FATAL_ERROR("No hidden terminals with this height, power and standard: neighbours decode each other up to "
+                           << rxRange << "m, routers two hops apart sense each other up to " << csRange << "m");
+        }
+        if (distance > rxRange) {
+            NS_FATAL_ERROR("--hidden=" << hidden << " places the routers beyond the receive range, use at most "
+                           << rxRange / csRange);
+        }
+        if (hidden <= 0.5) {
+            std::cerr << "Warning: --hidden=" << hidden << " does not create hidden terminals" << std::endl;
+        }
+    }
+
+    // Routers per row: all of them for the line, the square root (rounded up) for the grid
+    uint32_t columns = nodes;
+    if (layout == "grid") {
+        columns = (uint32_t) std::ceil(std::sqrt((double) nodes));
+    }
+    uint32_t rows = (nodes + columns - 1) / columns;
+
     //
     // Explicitly create the nodes required by the topology (shown above).
     //
     NS_LOG_INFO("Create nodes.");
 
     NodeContainer routers;
-    routers.Create(4);
+    routers.Create(nodes);
+    memory_report.Mark("nodes");
 
     //
     // Setup Wifi
@@ -158,17 +686,20 @@ main(int argc, char *argv[]) {
         wifi.EnableLogComponents();
     }
 
-    // Use 802.11g, like the specified TP Link Router
-    wifi.SetStandard(WIFI_PHY_STANDARD_80211g);
+    // Default: Use 802.11g, like the specified TP Link Router
+    wifiStandard.Configure(wifi);
 
-    YansWifiPhyHelper wifiPhy = YansWifiPhyHelper::Default();
+    YansWifiPhyHelper yansPhy = YansWifiPhyHelper::Default();
+    GridWifiPhyHelper gridPhy = GridWifiPhyHelper::Default();
+    SpectrumWifiPhyHelper spectrumPhy = SpectrumWifiPhyHelper::Default();
+    WifiPhyHelper &wifiPhy = (phy == "spectrum") ? static_cast<WifiPhyHelper &>(spectrumPhy) :
+                             (channel == "grid") ? static_cast<WifiPhyHelper &>(gridPhy) : yansPhy;
 
-    // Set Wifi parameters like specified
-    wifiPhy.Set("ChannelWidth", UintegerValue(20));
-    wifiPhy.Set("TxGain", DoubleValue(1.0));
-    wifiPhy.Set("RxGain", DoubleValue(1.0));
-    wifiPhy.Set("TxPowerStart", DoubleValue(1.0));
-    wifiPhy.Set("TxPowerEnd", DoubleValue(1.0));
+    // Set Wifi parameters like specified (the channel width is set by wifiStandard after the installation)
+    wifiPhy.Set("TxGain", DoubleValue(antenna_gain));
+    wifiPhy.Set("RxGain", DoubleValue(antenna_gain));
+    wifiPhy.Set("TxPowerStart", DoubleValue(tx_power));
+    wifiPhy.Set("TxPowerEnd", DoubleValue(tx_power));
     YansWifiChannelHelper wifiChannel;
     wifiChannel.SetPropagationDelay("ns3::ConstantSpeedPropagationDelayModel");
 
@@ -178,36 +709,196 @@ main(int argc, char *argv[]) {
     // => This means we assume the scenario stated above!
     //
 
-    wifiChannel.AddPropagationLoss("ns3::ItuR1411LosPropagationLossModel", "Frequency", DoubleValue(2400.0 * 1e6));
+    wifiChannel.AddPropagationLoss("ns3::ItuR1411LosPropagationLossModel", "Frequency", DoubleValue(wifiStandard.GetFrequency()));
     // wifiChannel.AddPropagationLoss ("ns3::FixedRssLossModel","Rss",DoubleValue (-80));
-    wifiPhy.SetChannel(wifiChannel.Create());
+    yansPhy.SetChannel(wifiChannel.Create());
+
+    // The same propagation models for the spatially culled channel
+    Ptr<GridWifiChannel> gridChannel;
+    if (channel == "grid") {
+        Ptr<ItuR1411LosPropagationLossModel> loss = CreateObject<ItuR1411LosPropagationLossModel>();
+        loss->SetAttribute("Frequency", DoubleValue(wifiStandard.GetFrequency()));
+        gridChannel = CreateObject<GridWifiChannel>();
+        gridChannel->SetPropagationLossModel(loss);
+        gridChannel->SetPropagationDelayModel(CreateObject<ConstantSpeedPropagationDelayModel>());
+        gridPhy.SetChannel(gridChannel);
+    }
+
+    // And on a spectrum channel, which delivers every signal to all PHYs as power spectral density
+    if (phy == "spectrum") {
+        Ptr<ItuR1411LosPropagationLossModel> loss = CreateObject<ItuR1411LosPropagationLossModel>();
+        loss->SetAttribute("Frequency", DoubleValue(wifiStandard.GetFrequency()));
+        Ptr<MultiModelSpectrumChannel> spectrumChannel = CreateObject<MultiModelSpectrumChannel>();
+        spectrumChannel->AddPropagationLossModel(loss);
+        spectrumChannel->SetPropagationDelayModel(CreateObject<ConstantSpeedPropagationDelayModel>());
+        spectrumPhy.SetChannel(spectrumChannel);
+    }
 
     ///
-    // Use MinstrelWifiManager like the exercise suggests
+    // Default: Use MinstrelWifiManager like the exercise suggests (set by wifiStandard.Configure)
     //
 
-    wifi.SetRemoteStationManager("ns3::MinstrelWifiManager");
     WifiMacHelper wifiMac;
     wifiMac.SetType("ns3::AdhocWifiMac");
 
     MobilityHelper mobility;
     Ptr<ListPositionAllocator> positionModel = CreateObject<ListPositionAllocator>();
-    mobility.SetMobilityModel("ns3::ConstantPositionMobilityModel");
-    for (uint32_t i = 0; i < routers.GetN(); ++i)
-    {
-        positionModel->Add(Vector(distance * i, height, height));
-        std::cerr << "Node " << i << " is at (" << distance * i << ", " << height << ", " << height << ")" << std::endl;
+    if (mobility_mode == "static") {
+        mobility.SetMobilityModel("ns3::ConstantPositionMobilityModel");
+    } else if (mobility_mode == "waypoint") {
+        //
+        // The routers start at their positions inside the chain (or grid) and move to random waypoints inside
+        // the area spanned by it. Their height does not change.
+        //
+        double length = distance * (columns - 1);
+        double width = distance * (rows - 1);
+        Ptr<RandomBoxPositionAllocator> waypoints = CreateObject<RandomBoxPositionAllocator>();
+        Ptr<UniformRandomVariable> x = CreateObject<UniformRandomVariable>();
+        x->SetAttribute("Min", DoubleValue(0.0));
+        x->SetAttribute("Max", DoubleValue(length));
+        Ptr<UniformRandomVariable> y = CreateObject<UniformRandomVariable>();
+        y->SetAttribute("Min", DoubleValue(height - distance / 2));
+        y->SetAttribute("Max", DoubleValue(height + width + distance / 2));
+        Ptr<ConstantRandomVariable> z = CreateObject<ConstantRandomVariable>();
+        z->SetAttribute("Constant", DoubleValue(height));
+        waypoints->SetX(x);
+        waypoints->SetY(y);
+        waypoints->SetZ(z);
+
+        std::ostringstream speedVariable;
+        speedVariable << "ns3::UniformRandomVariable[Min=0.0|Max=" << speed << "]";
+        std::ostringstream pauseVariable;
+        pauseVariable << "ns3::ConstantRandomVariable[Constant=" << pause << "]";
+        mobility.SetMobilityModel("ns3::RandomWaypointMobilityModel",
+                                  "Speed", StringValue(speedVariable.str()),
+                                  "Pause", StringValue(pauseVariable.str()),
+                                  "PositionAllocator", PointerValue(waypoints));
+    } else if (mobility_mode != "trace") {
+        NS_FATAL_ERROR("Unknown mobility mode " << mobility_mode);
     }
-    mobility.SetPositionAllocator(positionModel);
-    mobility.Install(routers);
 
-    NetDeviceContainer routerDevices = wifi.Install(wifiPhy, wifiMac, routers);
+    if (mobility_mode == "trace") {
+        if (mobility_trace.empty()) {
+            NS_FATAL_ERROR("--mobility=trace needs --mobility_trace");
+        }
+        if (!std::ifstream(mobility_trace.c_str())) {
+            NS_FATAL_ERROR("Unable to read mobility trace " << mobility_trace);
+        }
+        // Ns2MobilityHelper installs a ConstantVelocityMobilityModel on every node found inside the trace
+        // and silently skips all others
+        Ns2MobilityHelper ns2mobility(mobility_trace);
+        ns2mobility.Install(routers.Begin(), routers.End());
+        for (uint32_t i = 0; i < routers.GetN(); ++i) {
+            if (!routers.Get(i)->GetObject<MobilityModel>()) {
+                NS_FATAL_ERROR("Mobility trace " << mobility_trace << " does not cover router " << i);
+            }
+        }
+    } else {
+        for (uint32_t i = 0; i < routers.GetN(); ++i)
+        {
+            double x = distance * (i % columns);
+            double y = height + distance * (i / columns);
+            positionModel->Add(Vector(x, y, height));
+            std::cerr << "Node " << i << " is at (" << x << ", " << y << ", " << height << ")" << std::endl;
+        }
+        mobility.SetPositionAllocator(positionModel);
+        mobility.Install(routers);
+    }
+
+    if (mobility_mode != "static") {
+        if (routing == "static" || routing == "ns3") {
+            std::cerr << "Warning: Routers are moving, but static routes will not adapt" << std::endl;
+        }
+        for (uint32_t i = 0; i < routers.GetN(); ++i) {
+            routers.Get(i)->GetObject<MobilityModel>()->TraceConnectWithoutContext(
+                    "CourseChange", MakeCallback(&CourseChanged));
+        }
+    }
+
+    //
+    // Single channel: All routers share one ad-hoc network.
+    // Multi channel: Every hop is an ad-hoc network of its own. The hops are tuned to alternating channels,
+    // so the relays get one interface towards each neighbour.
+    //
+    // Hybrid: Every segment is an ad-hoc network of its own, the segments are connected by point-to-point links.
+    //
+    NetDeviceContainer routerDevices;
+    std::vector<NetDeviceContainer> hopDevices;
+    std::vector<NetDeviceContainer> segmentDevices;
+    std::vector<NetDeviceContainer> backhaulDevices;
+    uint32_t segment_size = nodes / segments;
+    PointToPointHelper backhaul;
+    backhaul.SetDeviceAttribute("DataRate", StringValue(backhaul_rate));
+    backhaul.SetChannelAttribute("Delay", StringValue(backhaul_delay));
+    if (!device_queue.empty()) {
+        backhaul.SetQueue("ns3::DropTailQueue", "MaxSize", StringValue(device_queue));
+    }
+    if (topology == "hybrid") {
+        for (uint32_t k = 0; k < segments; ++k) {
+            NodeContainer segment;
+            for (uint32_t j = 0; j < segment_size; ++j) {
+                segment.Add(routers.Get(k * segment_size + j));
+            }
+            NetDeviceContainer devices = wifi.Install(wifiPhy, wifiMac, segment);
+            wifiStandard.ConfigureDevices(devices);
+            wifiStandard.SetChannel(devices, k % radio_channels);
+            segmentDevices.push_back(devices);
+            routerDevices.Add(devices);
+            if (k > 0) {
+                backhaulDevices.push_back(backhaul.Install(routers.Get(k * segment_size - 1), routers.Get(k * segment_size)));
+            }
+        }
+    } else if (topology == "multichannel") {
+        for (uint32_t i = 0; i + 1 < routers.GetN(); ++i) {
+            NetDeviceContainer hop = wifi.Install(wifiPhy, wifiMac, NodeContainer(routers.Get(i), routers.Get(i + 1)));
+            wifiStandard.ConfigureDevices(hop);
+            wifiStandard.SetChannel(hop, i % radio_channels);
+            hopDevices.push_back(hop);
+            routerDevices.Add(hop);
+        }
+    } else {
+        routerDevices = wifi.Install(wifiPhy, wifiMac, routers);
+        wifiStandard.ConfigureDevices(routerDevices);
+    }
+
+    // The measurement window of the airtime and backhaul accounting ends as soon as maxBytes have been received
+    if (airtime) {
+        airtime_stats.Install(routerDevices);
+        airtime_stats.SetWindowStart(MilliSeconds(start_at));
+    }
+
+    if (energy) {
+        energy_stats.Install(routerDevices, energy_initial, energy_voltage);
+        energy_stats.SetWindowStart(MilliSeconds(start_at));
+    }
+
+    if (collisions) {
+        collision_stats.Install(routerDevices);
+        collision_stats.SetWindowStart(MilliSeconds(start_at));
+    }
+
+    backhaul_stats.SetWindowStart(MilliSeconds(start_at));
+    for (uint32_t i = 0; i < backhaulDevices.size(); ++i) {
+        backhaul_stats.Install(backhaulDevices[i]);
+    }
+
+    WifiFrameStats wifi_frame_stats;
+    if (frame_stats) {
+        wifi_frame_stats.Install(routerDevices);
+    }
+
+    memory_report.Mark("wifi");
 
     //
-    // Install the internet stack with OLSR on the nodes (IP)
+    // Install the internet stack with the chosen routing protocol on the nodes (IP)
     //
 
     OlsrHelper olsrhelper;
+    olsrhelper.Set("HelloInterval", TimeValue(MilliSeconds(olsr_hello)));
+    olsrhelper.Set("TcInterval", TimeValue(MilliSeconds(olsr_tc)));
+    olsrhelper.Set("MidInterval", TimeValue(MilliSeconds(olsr_mid)));
+    olsrhelper.Set("HnaInterval", TimeValue(MilliSeconds(olsr_hna)));
+    olsrhelper.Set("Willingness", StringValue(olsr_willingness));
     std::filebuf fb;
     fb.open("olsr.txt", std::ios::out);
     std::ostream os(&fb);
@@ -217,49 +908,142 @@ main(int argc, char *argv[]) {
     }
 
     InternetStackHelper internet;
-    if (olsr) internet.SetRoutingHelper(olsrhelper);
+    if (lean) {
+        internet.SetIpv6StackInstall(false);
+    }
+    AodvHelper aodv;
+    DsdvHelper dsdv;
+    if (routing == "olsr") {
+        internet.SetRoutingHelper(olsrhelper);
+    } else if (routing == "aodv") {
+        internet.SetRoutingHelper(aodv);
+    } else if (routing == "dsdv") {
+        internet.SetRoutingHelper(dsdv);
+    }
     internet.Install(routers);
 
+    if (routing == "dsr") {
+        // DSR is no Ipv4RoutingProtocol but an IP protocol of its own, it is installed on top of the stack
+        DsrHelper dsr;
+        DsrMainHelper dsrMain;
+        dsrMain.Install(dsr, routers);
+    }
+
+    RoutingOverheadStats routing_stats;
+    routing_stats.Install(routers);
+    memory_report.Mark("internet");
+
+    //
+    // Install the queue discs before the addresses are assigned, otherwise ns3 installs its default one
+    //
+    TrafficControlHelper trafficControl;
+    if (queue_limit.empty()) {
+        trafficControl.SetRootQueueDisc(queue_disc_type);
+    } else {
+        trafficControl.SetRootQueueDisc(queue_disc_type, "MaxSize", StringValue(queue_limit));
+    }
+    trafficControl.Install(routerDevices);
+    queue_disc_stats.Install(routerDevices);
+    for (uint32_t i = 0; i < backhaulDevices.size(); ++i) {
+        trafficControl.Install(backhaulDevices[i]);
+        queue_disc_stats.Install(backhaulDevices[i]);
+    }
+    queue_disc_stats.SetWindowStart(MilliSeconds(start_at));
+
     //
     // We've got the "hardware" in place.  Now we need to add IP addresses.
     //
     NS_LOG_INFO("Assign IP Addresses.");
     Ipv4AddressHelper ipv4;
-    ipv4.SetBase("10.1.2.0", "255.255.255.0");
-    Ipv4InterfaceContainer routerNet = ipv4.Assign(routerDevices);
+    // The hops of the chain, from the source (router 0) to the sink (last router)
+    std::vector<Hop> hops;
+    if (topology == "hybrid") {
+        // One subnet per segment: 10.3.1.0/24, 10.3.2.0/24, ... and per backhaul link: 10.4.1.0/24, ...
+        std::vector<Ipv4InterfaceContainer> segmentNets;
+        ipv4.SetBase("10.3.1.0", "255.255.255.0");
+        for (uint32_t k = 0; k < segmentDevices.size(); ++k) {
+            segmentNets.push_back(ipv4.Assign(segmentDevices[k]));
+            ipv4.NewNetwork();
+        }
+        std::vector<Ipv4InterfaceContainer> backhaulNets;
+        ipv4.SetBase("10.4.1.0", "255.255.255.0");
+        for (uint32_t k = 0; k < backhaulDevices.size(); ++k) {
+            backhaulNets.push_back(ipv4.Assign(backhaulDevices[k]));
+            ipv4.NewNetwork();
+        }
+        for (uint32_t i = 0; i + 1 < routers.GetN(); ++i) {
+            uint32_t k = i / segment_size;
+            uint32_t j = i % segment_size;
+            if (j + 1 < segment_size) {
+                hops.push_back(MakeHop(segmentDevices[k], segmentNets[k], j, j + 1));
+            } else {
+                hops.push_back(MakeHop(backhaulDevices[k], backhaulNets[k], 0, 1));
+            }
+        }
+    } else if (topology == "multichannel") {
+        // One subnet per hop: 10.2.1.0/24, 10.2.2.0/24, ...
+        ipv4.SetBase("10.2.1.0", "255.255.255.0");
+        for (uint32_t i = 0; i < hopDevices.size(); ++i) {
+            hops.push_back(MakeHop(hopDevices[i], ipv4.Assign(hopDevices[i]), 0, 1));
+            ipv4.NewNetwork();
+        }
+    } else {
+        if (routers.GetN() < 255) {
+            ipv4.SetBase("10.1.2.0", "255.255.255.0");
+        } else {
+            // Too many routers for a /24, keep counting from 10.1.2.1 inside 10.1.0.0/16
+            ipv4.SetBase("10.1.0.0", "255.255.0.0", "0.0.2.1");
+        }
+        Ipv4InterfaceContainer routerNet = ipv4.Assign(routerDevices);
+        for (uint32_t i = 0; i + 1 < routers.GetN(); ++i) {
+            hops.push_back(MakeHop(routerDevices, routerNet, i, i + 1));
+        }
+    }
+    Ipv4Address sourceAddress = hops.front().leftAddress;
+    Ipv4Address sinkAddress = hops.back().rightAddress;
 
+    if (routing == "olsr") {
+        // Track the next hop towards the sink on every router
+        route_sink = sinkAddress;
+        route_changes_from = MilliSeconds(start_at);
+        route_next_hops.resize(NodeList::GetNNodes());
+        route_source = sourceAddress;
+        route_sink_node = routers.Get(routers.GetN() - 1)->GetId();
+        route_complete.resize(NodeList::GetNNodes(), false);
+        routes_missing = routers.GetN();
+        for (uint32_t i = 0; i < routers.GetN(); ++i) {
+            routers.Get(i)->GetObject<olsr::RoutingProtocol>()->TraceConnectWithoutContext(
+                    "RoutingTableChanged", MakeBoundCallback(&OlsrRoutingTableChanged, routers.Get(i)->GetId()));
+        }
+    }
 
-    if (!olsr && !ns3routing) {
+
+    if (routing == "static") {
         //
-        // Set up static routing to the packets get routed along the 4 different routers
+        // Set up static routing so the packets get routed along all routers of the chain:
+        // Every router forwards towards the sink via its right and towards the source via its left neighbour.
+        // The neighbours of the sink and the source reach them directly.
+        // The next hop is the neighbour's address inside the subnet of the hop in between.
         //
-
-        Ptr<Ipv4> router1addr = routers.Get(0)->GetObject<Ipv4>();
-        Ptr<Ipv4> router2addr = routers.Get(1)->GetObject<Ipv4>();
-        Ptr<Ipv4> router3addr = routers.Get(2)->GetObject<Ipv4>();
-        Ptr<Ipv4> router4addr = routers.Get(3)->GetObject<Ipv4>();
         Ipv4StaticRoutingHelper staticRoutingHelper;
-
-        // Router 1 to Router 4 via router 2
-        Ptr<Ipv4StaticRouting> r1_l1tol2 = staticRoutingHelper.GetStaticRouting(router1addr);
-        r1_l1tol2->AddHostRouteTo(Ipv4Address("10.1.2.4"), Ipv4Address("10.1.2.2"), 1);
-
-        // Router 2 to Router 4 via router 3
-        Ptr<Ipv4StaticRouting> r2_l1tol2 = staticRoutingHelper.GetStaticRouting(router2addr);
-        r2_l1tol2->AddHostRouteTo(Ipv4Address("10.1.2.4"), Ipv4Address("10.1.2.3"), 1);
-
-        // Router 3 to Router 1 via via router 2
-        Ptr<Ipv4StaticRouting> r3_l1tol2 = staticRoutingHelper.GetStaticRouting(router3addr);
-        r3_l1tol2->AddHostRouteTo(Ipv4Address("10.1.2.1"), Ipv4Address("10.1.2.2"), 1);
-
-        // Router 4 to Router 1 via via router 3
-        Ptr<Ipv4StaticRouting> r4_l1tol2 = staticRoutingHelper.GetStaticRouting(router4addr);
-        r4_l1tol2->AddHostRouteTo(Ipv4Address("10.1.2.1"), Ipv4Address("10.1.2.3"), 1);
-    } else if(!olsr && ns3routing) {
+        uint32_t last = routers.GetN() - 1;
+        for (uint32_t i = 0; i < routers.GetN(); ++i) {
+            Ptr<Ipv4> ip = routers.Get(i)->GetObject<Ipv4>();
+            Ptr<Ipv4StaticRouting> routes = staticRoutingHelper.GetStaticRouting(ip);
+            if (i + 1 < last) {
+                routes->AddHostRouteTo(sinkAddress, hops[i].rightAddress, ip->GetInterfaceForDevice(hops[i].leftDevice));
+            }
+            if (i > 1) {
+                routes->AddHostRouteTo(sourceAddress, hops[i - 1].leftAddress,
+                                       ip->GetInterfaceForDevice(hops[i - 1].rightDevice));
+            }
+        }
+    } else if (routing == "ns3") {
         // Use ns3's routing helper (this will lead to static 1-hop-routing as everyone is in the same network segment)
         Ipv4GlobalRoutingHelper::PopulateRoutingTables();
     }
 
+    memory_report.Mark("addressing");
     NS_LOG_INFO("Create Applications.");
 
     //
@@ -271,15 +1055,51 @@ main(int argc, char *argv[]) {
 
 
     CustomBulkSendHelper source(socket_factory,
-                                InetSocketAddress(Ipv4Address("10.1.2.4"), port));
+                                InetSocketAddress(sinkAddress, port));
     // Set the amount of data to send in bytes.  Zero is unlimited.
     source.SetAttribute("MaxBytes", UintegerValue(maxBytes));
     // Set the amount of data to send per packet
     source.SetAttribute("SendSize", UintegerValue(send_size));
-    source.SetAttribute("UdpInterval", UintegerValue(udp_interval));
-    source.SetAttribute("UdpCount", UintegerValue(udp_count));
+    source.SetAttribute("TraceFile", StringValue(replay));
+    // The helper installs the UDP or the TCP sender, each has its own attributes
+    if (socket_factory == "ns3::UdpSocketFactory") {
+        if (connections > 1) {
+            NS_FATAL_ERROR("Parallel connections are only supported for TCP");
+        }
+        source.SetAttribute("UdpInterval", UintegerValue(udp_interval));
+        source.SetAttribute("UdpCount", UintegerValue(udp_count));
+    } else {
+        source.SetAttribute("Connections", UintegerValue(connections));
+        source.SetAttribute("PayloadFile", StringValue(payload_file));
+    }
 
-    if(!olsr_perf) {
+    Ptr<RequestResponseClient> request_client;
+    if (!olsr_perf && workload == "request_response") {
+        uint16_t rr_port = 7;
+        RequestResponseServerHelper server(InetSocketAddress(Ipv4Address::GetAny(), rr_port));
+        ApplicationContainer serverApps = server.Install(routers.Get(routers.GetN() - 1));
+        serverApps.Start(Seconds(0.0));
+        serverApps.Stop(Seconds(180.0));
+
+        RequestResponseClientHelper client(InetSocketAddress(sinkAddress, rr_port));
+        client.SetAttribute("Concurrency", UintegerValue(concurrency));
+        client.SetAttribute("MaxTransactions", UintegerValue(transactions));
+        std::ostringstream request_variable;
+        if (request_size_max > request_size) {
+            request_variable << "ns3::UniformRandomVariable[Min=" << request_size << "|Max=" << request_size_max << "]";
+        } else {
+            request_variable << "ns3::ConstantRandomVariable[Constant=" << request_size << "]";
+        }
+        client.SetAttribute("RequestSize", StringValue(request_variable.str()));
+        std::ostringstream response_variable;
+        response_variable << "ns3::ConstantRandomVariable[Constant=" << response_size << "]";
+        client.SetAttribute("ResponseSize", StringValue(response_variable.str()));
+        ApplicationContainer clientApps = client.Install(routers.Get(0));
+        clientApps.Start(MilliSeconds(start_at));
+        clientApps.Stop(Seconds(180.0));
+        request_client = DynamicCast<RequestResponseClient>(clientApps.Get(0));
+        request_client->SetCompleteCallback(MakeCallback(&TransferComplete));
+    } else if(!olsr_perf) {
         ApplicationContainer sourceApps = source.Install(routers.Get(0));
         sourceApps.Start(MilliSeconds(start_at));
         sourceApps.Stop(Seconds(180.0));
@@ -288,17 +1108,27 @@ main(int argc, char *argv[]) {
     }
 
     //
-    // Create a PacketSinkApplication and install it on laptop 2
+    // Create a CountingSink and install it on laptop 2
     //
-    PacketSinkHelper sink(socket_factory,
-                          InetSocketAddress(Ipv4Address::GetAny(), port));
-    ApplicationContainer sinkApps = sink.Install(routers.Get(3));
+    CountingSinkHelper sink(socket_factory,
+                            InetSocketAddress(Ipv4Address::GetAny(), port));
+    sink.SetAttribute("Checksum", BooleanValue(!payload_file.empty()));
+    ApplicationContainer sinkApps = sink.Install(routers.Get(routers.GetN() - 1));
 
     sinkApps.Start(Seconds(0.0));
     sinkApps.Stop(Seconds(180.0));
 
-    Ptr<PacketSink> sink1 = DynamicCast<PacketSink>(sinkApps.Get(0));
-    sink1->TraceConnectWithoutContext("Rx", MakeCallback(&RecvPacket));
+    Ptr<CountingSink> sink1 = DynamicCast<CountingSink>(sinkApps.Get(0));
+    sink1->SetThresholdCallback(maxBytes, MakeCallback(&TransferComplete));
+    ConnectionStats connection_stats;
+    connection_stats.Install(sink1, MilliSeconds(start_at));
+
+    LatencyProbe probe;
+    if (probe_interval > 0 && !olsr_perf) {
+        probe.Install(routers.Get(0), sinkAddress, MilliSeconds(probe_interval), MilliSeconds(start_at), Seconds(180.0));
+    }
+
+    memory_report.Mark("applications");
 
     //
     // Set up tracing if enabled
@@ -307,6 +1137,9 @@ main(int argc, char *argv[]) {
         AsciiTraceHelper ascii;
         wifiPhy.EnableAsciiAll(ascii.CreateFileStream("bulk-send.tr"));
         wifiPhy.EnablePcapAll("bulk-send", false);
+        if (topology == "hybrid") {
+            backhaul.EnablePcapAll("bulk-send-backhaul", false);
+        }
     }
 
     //
@@ -319,10 +1152,24 @@ main(int argc, char *argv[]) {
     // For every realisic scenario, 10s should be okay.
 
     Simulator::Stop(Seconds(180.0));
-    Simulator::Run();
+    schedulerHelper.Run();
+    memory_report.Mark("run");
+    Time simulation_end = Simulator::Now();
+    energy_stats.CloseWindow();
+    // An OLSR outage still open at the end is the longest one so far, at least
+    if (routing == "olsr" && routes_missing > 0 && !route_converged.IsNegative()) {
+        route_outage_max = std::max(route_outage_max, simulation_end - route_lost);
+    }
+    uint64_t scheduled_receptions = gridChannel ? gridChannel->GetScheduledReceptions() : 0;
+    uint64_t culled_receptions = gridChannel ? gridChannel->GetCulledReceptions() : 0;
     Simulator::Destroy();
     NS_LOG_INFO("Done.");
 
+    const CountingSink::Flow &received = sink1->GetTotal();
+    Time first_time_rx = received.first;
+    Time last_time_rx = received.last;
+    uint64_t packet_count_rx = received.rxPackets;
+    uint64_t packet_size_rx = received.rxBytes;
 
     std::cerr << "Total Bytes Received: " << sink1->GetTotalRx() << " ("
               << ((double) sink1->GetTotalRx() / maxBytes) * 100.0 << "%)" << std::endl;
@@ -340,6 +1187,100 @@ main(int argc, char *argv[]) {
     std::cout << "\"rx_ms_last\":" << last_time_rx.GetMilliSeconds() << ",";
     std::cout << "\"tx_bytes_packets\":" << packet_size_tx << ",";
     std::cout << "\"tx_count_packets\":" << packet_count_tx << ",";
-    std::cout << "\"tx_ms_last\":" << last_time_tx.GetMilliSeconds();
+    std::cout << "\"tx_ms_last\":" << last_time_tx.GetMilliSeconds() << ",";
+    std::cout << "\"tx_send_failures\":" << (bulk_send ? bulk_send->GetSendFailures() : 0) << ",";
+    std::cout << "\"course_changes\":" << course_changes << ",";
+    std::cout << "\"route_changes\":" << route_changes << ",";
+    std::cout << "\"rx_ms_first\":" << first_time_rx.GetMilliSeconds() << ",";
+    std::cout << "\"distance\":" << distance << ",";
+    std::cout << "\"phy\":\"" << phy << "\",";
+    std::cout << "\"goodput_bps\":" << (last_time_rx > MilliSeconds(start_at) ?
+                                          packet_size_rx * 8 / (last_time_rx - MilliSeconds(start_at)).GetSeconds() : 0.0) << ",";
+    std::cout << "\"queue_disc\":\"" << queue_disc << "\",";
+    std::cout << "\"queue_discs\":";
+    queue_disc_stats.PrintJson(std::cout);
+    std::cout << ",";
+    std::cout << "\"wifi\":";
+    wifiStandard.PrintJson(std::cout);
+    std::cout << ",";
+    std::cout << "\"tcp\":";
+    tcpConfig.PrintJson(std::cout);
+    std::cout << ",";
+    std::cout << "\"routing\":";
+    routing_stats.PrintJson(std::cout);
+    std::cout << ",\"connections\":";
+    connection_stats.PrintJson(std::cout);
+    std::cout << ",\"simulator\":";
+    schedulerHelper.PrintJson(std::cout);
+    if (frame_stats) {
+        std::cout << ",\"frames\":";
+        wifi_frame_stats.PrintJson(std::cout);
+    }
+    if (gridChannel) {
+        std::cout << ",\"channel\":{";
+        std::cout << "\"scheduled_receptions\":" << scheduled_receptions << ",";
+        std::cout << "\"culled_receptions\":" << culled_receptions;
+        std::cout << "}";
+    }
+    if (topology == "hybrid") {
+        std::cout << ",\"backhaul\":";
+        backhaul_stats.PrintJson(std::cout, simulation_end);
+    }
+    if (routing == "olsr") {
+        std::cout << ",\"olsr\":{";
+        std::cout << "\"hello_ms\":" << olsr_hello << ",";
+        std::cout << "\"tc_ms\":" << olsr_tc << ",";
+        std::cout << "\"mid_ms\":" << olsr_mid << ",";
+        std::cout << "\"hna_ms\":" << olsr_hna << ",";
+        std::cout << "\"willingness\":\"" << olsr_willingness << "\",";
+        std::cout << "\"convergence_ms\":" << (route_converged.IsNegative() ? -1 : route_converged.GetMilliSeconds()) << ",";
+        std::cout << "\"outages\":" << route_outages << ",";
+        std::cout << "\"outage_max_ms\":" << route_outage_max.GetMilliSeconds() << ",";
+        std::cout << "\"control_bytes_per_s\":"
+                  << (simulation_end.IsStrictlyPositive() ? routing_stats.GetControlBytes() / simulation_end.GetSeconds() : 0.0);
+        std::cout << "}";
+    }
+    if (energy) {
+        std::cout << ",\"energy\":";
+        // Request/response: the bulk sink receives nothing, count the requests and responses instead
+        energy_stats.PrintJson(std::cout, request_client ? request_client->GetDeliveredBytes() : sink1->GetTotalRx());
+    }
+    if (memory) {
+        std::cout << ",\"memory\":";
+        memory_report.PrintJson(std::cout);
+    }
+    if (!payload_file.empty()) {
+        // TCP delivers the file as a single, reassembled byte stream
+        Ptr<TcpBulkSendApplication> tcp_send = DynamicCast<TcpBulkSendApplication>(bulk_send);
+        uint64_t checksum_tx = tcp_send ? tcp_send->GetPayloadChecksum() : 0;
+        uint64_t checksum_rx = sink1->GetFlows().empty() ? PayloadChecksum().Get() : sink1->GetFlows()[0].checksum.Get();
+        bool verified = sink1->GetFlows().size() == 1 && sink1->GetTotalRx() == maxBytes && checksum_rx == checksum_tx;
+        std::cerr << "Payload " << payload_file << (verified ? " verified" : " NOT verified") << std::endl;
+        std::cout << ",\"payload\":{";
+        std::cout << "\"file\":\"" << payload_file << "\",";
+        std::cout << "\"bytes\":" << maxBytes << ",";
+        std::cout << "\"rx_bytes\":" << sink1->GetTotalRx() << ",";
+        std::cout << "\"checksum_tx\":\"" << std::hex << checksum_tx << "\",";
+        std::cout << "\"checksum_rx\":\"" << checksum_rx << std::dec << "\",";
+        std::cout << "\"verified\":" << (verified ? "true" : "false") << ",";
+        std::cout << "\"completion_ms\":" << (verified ? (last_time_rx - MilliSeconds(start_at)).GetMilliSeconds() : -1);
+        std::cout << "}";
+    }
+    if (request_client) {
+        std::cout << ",\"request_response\":";
+        request_client->PrintJson(std::cout);
+    }
+    if (probe_interval > 0) {
+        std::cout << ",\"probe\":";
+        probe.PrintJson(std::cout);
+    }
+    if (collisions) {
+        std::cout << ",\"collisions\":";
+        collision_stats.PrintJson(std::cout);
+    }
+    if (airtime) {
+        std::cout << ",\"airtime\":";
+        airtime_stats.PrintJson(std::cout, simulation_end);
+    }
     std::cout << "}";
 }
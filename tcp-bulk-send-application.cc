@@ -0,0 +1,396 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2010 Georgia Institute of Technology
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: George F. Riley <riley@ece.gatech.edu>
+ */
+
+// Kommunikation in verteilten Systemen - Simulation Model 1
+// TCP engine of the bulk sender, adapted from ns3's bulk-send-application code.
+// The send loop fills the send buffer of the socket and is called again by the send callback as soon as
+// space has been freed. A stream socket accepts a packet completely or not at all, so there are no partial sends.
+// When replaying a trace, data which does not fit into the send buffer is only remembered as number of bytes,
+// so memory usage does not depend on the length of the trace.
+// When the Connections attribute is larger than one, MaxBytes is striped across that many TCP connections.
+// The parallel connections are kept in m_stripes, a single connection only uses m_socket. Both share the send
+// loop (SendBulk), only the socket and the byte counters differ.
+// When the PayloadFile attribute is set, the file is mapped with mmap and every packet is created from the mapping
+// at the offset of the bytes sent so far, which always matches the stream position. Packets with real payload own
+// their bytes, unlike the zero-filled ones, so the memory of the packets in flight grows with their size.
+
+#include <algorithm>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "ns3/log.h"
+#include "ns3/socket.h"
+#include "ns3/simulator.h"
+#include "ns3/packet.h"
+#include "ns3/uinteger.h"
+#include "ns3/string.h"
+#include "tcp-bulk-send-application.h"
+
+namespace ns3 {
+
+    NS_LOG_COMPONENT_DEFINE ("TcpBulkSendApplication");
+
+    NS_OBJECT_ENSURE_REGISTERED (TcpBulkSendApplication);
+
+    TypeId
+    TcpBulkSendApplication::GetTypeId(void) {
+        static TypeId tid = TypeId("ns3::TcpBulkSendApplication")
+                .SetParent<CustomBulkSendApplication>()
+                .SetGroupName("Applications")
+                .AddConstructor<TcpBulkSendApplication>()
+                .AddAttribute("Connections",
+                              "Number of parallel TCP connections MaxBytes is striped across.",
+                              UintegerValue(1),
+                              MakeUintegerAccessor(&TcpBulkSendApplication::m_connections),
+                              MakeUintegerChecker<uint32_t>(1))
+                .AddAttribute("PayloadFile",
+                              "Send the contents of this file instead of zero-filled packets. "
+                              "Empty for zero-filled packets.",
+                              StringValue(""),
+                              MakeStringAccessor(&TcpBulkSendApplication::m_payloadFile),
+                              MakeStringChecker());
+        return tid;
+    }
+
+
+    TcpBulkSendApplication::TcpBulkSendApplication()
+            : m_connected(false),
+              m_replayBacklog(0),
+              m_payload(0),
+              m_payloadSize(0),
+              m_connections(1) {
+        NS_LOG_FUNCTION (this);
+    }
+
+    TcpBulkSendApplication::~TcpBulkSendApplication() {
+        NS_LOG_FUNCTION (this);
+    }
+
+    uint64_t
+    TcpBulkSendApplication::GetPayloadChecksum(void) const {
+        return m_payloadChecksum.Get();
+    }
+
+    void
+    TcpBulkSendApplication::DoDispose(void) {
+        NS_LOG_FUNCTION (this);
+
+        m_stripes.clear();
+        UnmapPayload();
+        // chain up
+        CustomBulkSendApplication::DoDispose();
+    }
+
+// Application Methods
+    void TcpBulkSendApplication::StartApplication(void) // Called at time specified by Start
+    {
+        NS_LOG_FUNCTION (this);
+
+        if (!m_payloadFile.empty() && !m_payload) {
+            MapPayload();
+        }
+
+        if (m_connections > 1) {
+            StartStripes();
+            return;
+        }
+
+        // Create the socket if not already
+        if (!m_socket) {
+            m_socket = CreateConnectedSocket();
+            if (m_socket->GetSocketType() != Socket::NS3_SOCK_STREAM &&
+                m_socket->GetSocketType() != Socket::NS3_SOCK_SEQPACKET) {
+                NS_FATAL_ERROR ("TcpBulkSendApplication needs a stream socket, datagrams are sent by UdpBulkSendApplication");
+            }
+            m_socket->SetConnectCallback(
+                    MakeCallback(&TcpBulkSendApplication::ConnectionSucceeded, this),
+                    MakeCallback(&TcpBulkSendApplication::ConnectionFailed, this));
+            m_socket->SetSendCallback(
+                    MakeCallback(&TcpBulkSendApplication::DataSend, this));
+        }
+        if (m_connected) {
+            StartSending();
+        }
+    }
+
+    void TcpBulkSendApplication::StopApplication(void) // Called at time specified by Stop
+    {
+        NS_LOG_FUNCTION (this);
+
+        for (std::vector<Stripe>::iterator i = m_stripes.begin(); i != m_stripes.end(); ++i) {
+            if (i->connected) {
+                i->socket->Close();
+                i->connected = false;
+            }
+        }
+        m_connected = false;
+        CustomBulkSendApplication::StopApplication();
+    }
+
+
+// Private helpers
+
+    void TcpBulkSendApplication::SendData(void) {
+        NS_LOG_FUNCTION (this);
+
+        if (SendBulk(m_socket, m_maxBytes, m_totBytes)) {
+            m_connected = false;
+            NS_LOG_INFO("All packets sent at " << Simulator::Now());
+        }
+    }
+
+    bool TcpBulkSendApplication::SendBulk(Ptr<Socket> socket, uint64_t maxBytes, uint64_t &sent) {
+        NS_LOG_FUNCTION (this << socket << maxBytes << sent);
+
+        while (maxBytes == 0 || sent < maxBytes) { // Time to send more
+            // uint64_t to allow the comparison later.
+            // the result is in a uint32_t range anyway, because
+            // m_sendSize is uint32_t.
+            uint64_t toSend = m_sendSize;
+            // Make sure we don't send too many
+            if (maxBytes > 0) {
+                toSend = std::min(toSend, maxBytes - sent);
+            }
+
+            NS_LOG_LOGIC ("sending packet at " << Simulator::Now());
+            // The payload is only sent over a single connection, so the bytes sent are the stream position
+            Ptr<Packet> packet = m_payload ? Create<Packet>(m_payload + sent, toSend) : Create<Packet>(toSend);
+            // We exit this loop when the send side buffer is full. The "DataSent"
+            // callback will pop when some buffer space has freed up.
+            if (socket->Send(packet) <= 0) {
+                break;
+            }
+            sent += toSend;
+            m_txTrace(packet);
+        }
+        // Check if time to close (all sent); with MaxBytes zero the connection stays open
+        if (maxBytes > 0 && sent >= maxBytes) {
+            socket->Close();
+            return true;
+        }
+        return false;
+    }
+
+    void TcpBulkSendApplication::StartSending(void) {
+        NS_LOG_FUNCTION (this);
+
+        if (m_traceFile.empty()) {
+            SendData();
+        } else {
+            StartReplay();
+        }
+    }
+
+    void TcpBulkSendApplication::ReplayTraceRecord(void) {
+        NS_LOG_FUNCTION (this);
+
+        uint64_t toSend = m_traceSize;
+        if (m_maxBytes > 0) {
+            toSend = std::min(toSend, m_maxBytes - m_totBytes - m_replayBacklog);
+        }
+        m_replayBacklog += toSend;
+        SendReplayBacklog();
+
+        if ((m_maxBytes == 0 || m_totBytes + m_replayBacklog < m_maxBytes) && ReadTraceRecord()) {
+            ScheduleReplay();
+            return;
+        }
+
+        // Trace finished (or MaxBytes reached). Close as soon as the backlog has been handed to the socket.
+        m_traceDone = true;
+        if (m_replayBacklog == 0 && m_connected) {
+            m_socket->Close();
+            m_connected = false;
+            NS_LOG_INFO("Trace replayed at " << Simulator::Now());
+        }
+    }
+
+    void TcpBulkSendApplication::SendReplayBacklog(void) {
+        NS_LOG_FUNCTION (this);
+
+        while (m_replayBacklog > 0) {
+            uint32_t toSend = std::min<uint64_t>(m_sendSize, m_replayBacklog);
+            Ptr<Packet> packet = Create<Packet>(toSend);
+            if (m_socket->Send(packet) <= 0) {
+                // The send buffer is full, DataSend will call us again
+                break;
+            }
+            m_totBytes += toSend;
+            m_replayBacklog -= toSend;
+            m_txTrace(packet);
+        }
+
+        if (m_traceDone && m_replayBacklog == 0 && m_connected) {
+            m_socket->Close();
+            m_connected = false;
+            NS_LOG_INFO("Trace replayed at " << Simulator::Now());
+        }
+    }
+
+    void TcpBulkSendApplication::MapPayload(void) {
+        NS_LOG_FUNCTION (this);
+
+        if (m_connections > 1 || !m_traceFile.empty()) {
+            NS_FATAL_ERROR ("A payload file can only be sent over a single connection without a trace");
+        }
+
+        int fd = open(m_payloadFile.c_str(), O_RDONLY);
+        if (fd == -1) {
+            NS_FATAL_ERROR ("Unable to open payload file " << m_payloadFile);
+        }
+        struct stat st;
+        if (fstat(fd, &st) == -1 || st.st_size == 0) {
+            close(fd);
+            NS_FATAL_ERROR ("Unable to map empty payload file " << m_payloadFile);
+        }
+        void *data = mmap(0, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        // The mapping stays valid after the descriptor has been closed
+        close(fd);
+        if (data == MAP_FAILED) {
+            NS_FATAL_ERROR ("Unable to map payload file " << m_payloadFile);
+        }
+        madvise(data, st.st_size, MADV_SEQUENTIAL);
+
+        m_payload = static_cast<const uint8_t *>(data);
+        m_payloadSize = st.st_size;
+        if (m_maxBytes == 0 || m_maxBytes > m_payloadSize) {
+            m_maxBytes = m_payloadSize;
+        }
+        m_payloadChecksum.Update(m_payload, m_maxBytes);
+        NS_LOG_INFO("Mapped " << m_payloadSize << " bytes of " << m_payloadFile);
+    }
+
+    void TcpBulkSendApplication::UnmapPayload(void) {
+        if (m_payload) {
+            munmap(const_cast<uint8_t *>(m_payload), m_payloadSize);
+            m_payload = 0;
+            m_payloadSize = 0;
+        }
+    }
+
+    void TcpBulkSendApplication::ConnectionSucceeded(Ptr<Socket> socket) {
+        NS_LOG_FUNCTION (this << socket);
+        NS_LOG_LOGIC ("TcpBulkSendApplication Connection succeeded");
+        m_connected = true;
+        StartSending();
+    }
+
+    void TcpBulkSendApplication::ConnectionFailed(Ptr<Socket> socket) {
+        NS_LOG_FUNCTION (this << socket);
+        NS_LOG_LOGIC ("TcpBulkSendApplication, Connection Failed");
+    }
+
+    void TcpBulkSendApplication::DataSend(Ptr<Socket>, uint32_t) {
+        NS_LOG_FUNCTION (this);
+
+        if (m_connected) { // Only send new data if the connection has completed
+            if (m_traceFile.empty()) {
+                SendData();
+            } else {
+                SendReplayBacklog();
+            }
+        }
+    }
+
+    void TcpBulkSendApplication::StartStripes(void) {
+        NS_LOG_FUNCTION (this);
+
+        if (!m_stripes.empty()) {
+            // Restarted: continue on the connections which are still open
+            for (std::vector<Stripe>::iterator i = m_stripes.begin(); i != m_stripes.end(); ++i) {
+                if (i->connected) {
+                    SendStripe(*i);
+                }
+            }
+            return;
+        }
+        if (!m_traceFile.empty()) {
+            NS_FATAL_ERROR ("Parallel connections cannot replay a trace");
+        }
+
+        // The stripes must not be moved once the sockets refer to them, so reserve them up front
+        m_stripes.resize(m_connections);
+        for (uint32_t i = 0; i < m_connections; ++i) {
+            Stripe &stripe = m_stripes[i];
+            // Split MaxBytes as evenly as possible, the first connections take the remainder
+            stripe.maxBytes = m_maxBytes / m_connections + (i < m_maxBytes % m_connections ? 1 : 0);
+            stripe.totBytes = 0;
+            stripe.connected = false;
+            if (m_maxBytes > 0 && stripe.maxBytes == 0) {
+                // Fewer bytes than connections
+                continue;
+            }
+
+            stripe.socket = CreateConnectedSocket();
+            if (stripe.socket->GetSocketType() != Socket::NS3_SOCK_STREAM &&
+                stripe.socket->GetSocketType() != Socket::NS3_SOCK_SEQPACKET) {
+                NS_FATAL_ERROR ("Parallel connections are only supported for TCP");
+            }
+            stripe.socket->SetConnectCallback(
+                    MakeCallback(&TcpBulkSendApplication::StripeConnectionSucceeded, this),
+                    MakeCallback(&TcpBulkSendApplication::ConnectionFailed, this));
+            stripe.socket->SetSendCallback(
+                    MakeCallback(&TcpBulkSendApplication::StripeDataSend, this));
+        }
+    }
+
+    void TcpBulkSendApplication::SendStripe(Stripe &stripe) {
+        NS_LOG_FUNCTION (this);
+
+        uint64_t before = stripe.totBytes;
+        bool done = SendBulk(stripe.socket, stripe.maxBytes, stripe.totBytes);
+        // m_totBytes counts the bytes of all connections
+        m_totBytes += stripe.totBytes - before;
+        if (done) {
+            stripe.connected = false;
+            NS_LOG_INFO("All packets of a connection sent at " << Simulator::Now());
+        }
+    }
+
+    TcpBulkSendApplication::Stripe *
+    TcpBulkSendApplication::FindStripe(Ptr<Socket> socket) {
+        // There are only a handful of connections, a linear search is fine
+        for (std::vector<Stripe>::iterator i = m_stripes.begin(); i != m_stripes.end(); ++i) {
+            if (i->socket == socket) {
+                return &*i;
+            }
+        }
+        return 0;
+    }
+
+    void TcpBulkSendApplication::StripeConnectionSucceeded(Ptr<Socket> socket) {
+        NS_LOG_FUNCTION (this << socket);
+        Stripe *stripe = FindStripe(socket);
+        if (stripe) {
+            stripe->connected = true;
+            SendStripe(*stripe);
+        }
+    }
+
+    void TcpBulkSendApplication::StripeDataSend(Ptr<Socket> socket, uint32_t) {
+        NS_LOG_FUNCTION (this);
+        Stripe *stripe = FindStripe(socket);
+        if (stripe && stripe->connected) {
+            SendStripe(*stripe);
+        }
+    }
+
+} // Namespace ns3
@@ -0,0 +1,186 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2010 Georgia Institute of Technology
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: George F. Riley <riley@ece.gatech.edu>
+ */
+
+#ifndef TCP_BULK_SEND_APPLICATION_H
+#define TCP_BULK_SEND_APPLICATION_H
+
+#include <vector>
+#include "custom-bulk-send-application.h"
+#include "payload-checksum.h"
+
+namespace ns3 {
+
+/**
+ * \ingroup bulksend
+ *
+ * \brief Send as much traffic as possible over a stream socket, trying to fill the bandwidth.
+ *
+ * Once the lower layer send buffer is filled, it waits until space is free
+ * to send more data, essentially keeping a constant flow of data. Only
+ * SOCK_STREAM and SOCK_SEQPACKET sockets are supported. The connection is
+ * closed as soon as MaxBytes have been handed to the socket.
+ *
+ * If Connections is larger than one, the application opens this many TCP
+ * connections to the remote and stripes MaxBytes across them: every connection
+ * sends its own share of the data as fast as possible. This is only supported
+ * for bulk transfers.
+ *
+ * If a PayloadFile is given, the packets carry the contents of this file
+ * instead of zeros. The file is memory-mapped and the packets are created
+ * straight from the mapping, so it is never read into a buffer of its own.
+ * MaxBytes is limited to the size of the file. This is only supported for a
+ * single connection, so the receiver gets the file as one byte stream and
+ * can compare its checksum to GetPayloadChecksum.
+ */
+    class TcpBulkSendApplication : public CustomBulkSendApplication {
+    public:
+        /**
+         * \brief Get the type ID.
+         * \return the object TypeId
+         */
+        static TypeId GetTypeId(void);
+
+        TcpBulkSendApplication();
+
+        virtual ~TcpBulkSendApplication();
+
+        /**
+         * \brief Get the checksum of the payload to be sent (the first MaxBytes bytes of the PayloadFile).
+         * \return the checksum, only valid once the application has been started
+         */
+        uint64_t GetPayloadChecksum(void) const;
+
+    protected:
+        virtual void DoDispose(void);
+
+    private:
+        // inherited from Application base class.
+        virtual void StartApplication(void);    // Called at time specified by Start
+        virtual void StopApplication(void);     // Called at time specified by Stop
+
+        /**
+         * \brief Send data until the L4 transmission buffer is full.
+         */
+        void SendData(void);
+
+        /**
+         * \brief Send data over a connection until its transmission buffer is full, close it once all is sent.
+         *
+         * The send loop of the single connection and of every parallel one.
+         *
+         * \param socket the socket of the connection
+         * \param maxBytes the bytes to send over the connection (0: unlimited)
+         * \param sent the bytes sent over the connection so far, updated
+         * \return true if all bytes have been sent and the socket has been closed
+         */
+        bool SendBulk(Ptr<Socket> socket, uint64_t maxBytes, uint64_t &sent);
+
+        /**
+         * \brief Start sending once the socket is ready (either bulk data or the replayed trace).
+         */
+        void StartSending(void);
+
+        // inherited from CustomBulkSendApplication
+        virtual void ReplayTraceRecord(void);
+
+        /**
+         * \brief Hand the bytes of the trace which have not been accepted by the socket yet over to it.
+         */
+        void SendReplayBacklog(void);
+
+        /**
+         * \brief Map the PayloadFile into memory and checksum the part of it which will be sent.
+         */
+        void MapPayload(void);
+
+        /**
+         * \brief Release the mapping of the PayloadFile.
+         */
+        void UnmapPayload(void);
+
+        /// One of the parallel connections of a striped transfer
+        struct Stripe {
+            Ptr<Socket> socket;     //!< The socket of the connection
+            uint64_t maxBytes;      //!< Share of MaxBytes to send over this connection (0: unlimited)
+            uint64_t totBytes;      //!< Bytes sent over this connection so far
+            bool connected;         //!< True if connected
+        };
+
+        /**
+         * \brief Open the parallel connections and split MaxBytes between them.
+         */
+        void StartStripes(void);
+
+        /**
+         * \brief Send data over one of the parallel connections until its transmission buffer is full.
+         * \param stripe the connection to send over
+         */
+        void SendStripe(Stripe &stripe);
+
+        /**
+         * \brief Find the parallel connection a socket belongs to.
+         * \param socket the socket
+         * \return the connection, 0 if the socket is unknown
+         */
+        Stripe *FindStripe(Ptr<Socket> socket);
+
+        /**
+         * \brief A parallel connection has been established (called by Socket through a callback)
+         * \param socket the connected socket
+         */
+        void StripeConnectionSucceeded(Ptr<Socket> socket);
+
+        /**
+         * \brief Send more data over a parallel connection as soon as some has been transmitted.
+         */
+        void StripeDataSend(Ptr<Socket> socket, uint32_t);
+
+        /**
+         * \brief Connection Succeeded (called by Socket through a callback)
+         * \param socket the connected socket
+         */
+        void ConnectionSucceeded(Ptr<Socket> socket);
+
+        /**
+         * \brief Connection Failed (called by Socket through a callback)
+         * \param socket the connected socket
+         */
+        void ConnectionFailed(Ptr<Socket> socket);
+
+        /**
+         * \brief Send more data as soon as some has been transmitted.
+         */
+        void DataSend(Ptr<Socket>, uint32_t); // for socket's SetSendCallback
+
+        bool m_connected;           //!< True if connected
+        uint64_t m_replayBacklog;   //!< Bytes of the trace due which did not fit into the send buffer yet
+
+        std::string m_payloadFile;          //!< File to send, empty for zero-filled packets
+        const uint8_t *m_payload;           //!< The mapped PayloadFile, 0 if not mapped
+        uint64_t m_payloadSize;             //!< Size of the mapping
+        PayloadChecksum m_payloadChecksum;  //!< Checksum of the bytes to be sent
+
+        uint32_t m_connections;         //!< Number of parallel connections
+        std::vector<Stripe> m_stripes;  //!< The parallel connections, empty for a single connection
+    };
+
+} // namespace ns3
+
+#endif /* TCP_BULK_SEND_APPLICATION_H */
@@ -0,0 +1,122 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// Kommunikation in verteilten Systemen - TCP configuration
+// The congestion control is selected like in the tcp-variants-comparison example: TcpL4Protocol creates its
+// sockets with the congestion control given by its SocketType attribute. Westwood+ is TcpWestwood running
+// the WESTWOODPLUS bandwidth estimation.
+
+#include "ns3/log.h"
+#include "ns3/config.h"
+#include "ns3/boolean.h"
+#include "ns3/enum.h"
+#include "ns3/uinteger.h"
+#include "ns3/type-id.h"
+#include "ns3/tcp-westwood.h"
+#include "tcp-config-helper.h"
+
+namespace ns3 {
+
+    NS_LOG_COMPONENT_DEFINE ("TcpConfigHelper");
+
+    TcpConfigHelper::TcpConfigHelper()
+            : m_variant("newreno"),
+              m_sack(true),
+              m_windowScaling(true),
+              m_segmentSize(536),
+              m_sndBufSize(131072),
+              m_rcvBufSize(131072) {
+    }
+
+    void
+    TcpConfigHelper::SetVariant(std::string variant) {
+        m_variant = variant;
+    }
+
+    void
+    TcpConfigHelper::SetOptions(bool sack, bool windowScaling) {
+        m_sack = sack;
+        m_windowScaling = windowScaling;
+    }
+
+    void
+    TcpConfigHelper::SetSegmentSize(uint32_t segmentSize) {
+        m_segmentSize = segmentSize;
+    }
+
+    void
+    TcpConfigHelper::SetBufferSizes(uint32_t sndBufSize, uint32_t rcvBufSize) {
+        m_sndBufSize = sndBufSize;
+        m_rcvBufSize = rcvBufSize;
+    }
+
+    void
+    TcpConfigHelper::Configure(void) const {
+        static const char *variants[][2] = {
+                {"newreno", "ns3::TcpNewReno"},
+                {"westwood", "ns3::TcpWestwood"},
+                {"westwoodplus", "ns3::TcpWestwood"},
+                {"vegas", "ns3::TcpVegas"},
+                {"bic", "ns3::TcpBic"},
+                {"hybla", "ns3::TcpHybla"},
+                {"highspeed", "ns3::TcpHighSpeed"},
+                {"htcp", "ns3::TcpHtcp"},
+                {"scalable", "ns3::TcpScalable"},
+                {"veno", "ns3::TcpVeno"},
+                {"yeah", "ns3::TcpYeah"},
+                {"illinois", "ns3::TcpIllinois"},
+                {"ledbat", "ns3::TcpLedbat"},
+                {"lp", "ns3::TcpLp"}
+        };
+
+        std::string typeName;
+        for (size_t i = 0; i < sizeof(variants) / sizeof(variants[0]); ++i) {
+            if (m_variant == variants[i][0]) {
+                typeName = variants[i][1];
+                break;
+            }
+        }
+        if (typeName.empty()) {
+            NS_FATAL_ERROR("Unknown TCP variant " << m_variant);
+        }
+
+        Config::SetDefault("ns3::TcpL4Protocol::SocketType", TypeIdValue(TypeId::LookupByName(typeName)));
+        if (m_variant == "westwood") {
+            Config::SetDefault("ns3::TcpWestwood::ProtocolType", EnumValue(TcpWestwood::WESTWOOD));
+        } else if (m_variant == "westwoodplus") {
+            Config::SetDefault("ns3::TcpWestwood::ProtocolType", EnumValue(TcpWestwood::WESTWOODPLUS));
+        }
+
+        Config::SetDefault("ns3::TcpSocketBase::Sack", BooleanValue(m_sack));
+        Config::SetDefault("ns3::TcpSocketBase::WindowScaling", BooleanValue(m_windowScaling));
+        Config::SetDefault("ns3::TcpSocket::SegmentSize", UintegerValue(m_segmentSize));
+        Config::SetDefault("ns3::TcpSocket::SndBufSize", UintegerValue(m_sndBufSize));
+        Config::SetDefault("ns3::TcpSocket::RcvBufSize", UintegerValue(m_rcvBufSize));
+    }
+
+    void
+    TcpConfigHelper::PrintJson(std::ostream &os) const {
+        os << "{";
+        os << "\"variant\":\"" << m_variant << "\",";
+        os << "\"sack\":" << (m_sack ? "true" : "false") << ",";
+        os << "\"window_scaling\":" << (m_windowScaling ? "true" : "false") << ",";
+        os << "\"segment_size\":" << m_segmentSize << ",";
+        os << "\"snd_buf_size\":" << m_sndBufSize << ",";
+        os << "\"rcv_buf_size\":" << m_rcvBufSize;
+        os << "}";
+    }
+
+} // namespace ns3
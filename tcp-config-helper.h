@@ -0,0 +1,83 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef TCP_CONFIG_HELPER_H
+#define TCP_CONFIG_HELPER_H
+
+#include <ostream>
+#include <string>
+#include <stdint.h>
+
+namespace ns3 {
+
+/**
+ * \brief Configure the TCP congestion control and the socket options of all TCP sockets.
+ *
+ * Supported congestion controls are newreno, westwood, westwoodplus, vegas, bic, hybla,
+ * highspeed, htcp, scalable, veno, yeah, illinois, ledbat and lp. The settings are applied
+ * as attribute defaults, so Configure must be called before any TCP socket is created.
+ * The defaults of this helper are the defaults of ns3.
+ */
+    class TcpConfigHelper {
+    public:
+        TcpConfigHelper();
+
+        /**
+         * \param variant the name of the congestion control (see above)
+         */
+        void SetVariant(std::string variant);
+
+        /**
+         * \param sack enable selective acknowledgements
+         * \param windowScaling enable the window scale option
+         */
+        void SetOptions(bool sack, bool windowScaling);
+
+        /**
+         * \param segmentSize the maximum segment size in bytes
+         */
+        void SetSegmentSize(uint32_t segmentSize);
+
+        /**
+         * \param sndBufSize the size of the send buffer in bytes
+         * \param rcvBufSize the size of the receive buffer in bytes
+         */
+        void SetBufferSizes(uint32_t sndBufSize, uint32_t rcvBufSize);
+
+        /**
+         * Set the attribute defaults of the TCP sockets.
+         */
+        void Configure(void) const;
+
+        /**
+         * Print the configuration as JSON object.
+         *
+         * \param os the stream to print to
+         */
+        void PrintJson(std::ostream &os) const;
+
+    private:
+        std::string m_variant;      //!< Name of the congestion control
+        bool m_sack;                //!< Selective acknowledgements enabled
+        bool m_windowScaling;       //!< Window scale option enabled
+        uint32_t m_segmentSize;     //!< Maximum segment size in bytes
+        uint32_t m_sndBufSize;      //!< Send buffer size in bytes
+        uint32_t m_rcvBufSize;      //!< Receive buffer size in bytes
+    };
+
+} // namespace ns3
+
+#endif /* TCP_CONFIG_HELPER_H */
@@ -0,0 +1,179 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2010 Georgia Institute of Technology
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: George F. Riley <riley@ece.gatech.edu>
+ */
+
+// Kommunikation in verteilten Systemen - Simulation Model 1
+// UDP engine of the bulk sender. ns3's bulk-send-application only supports stream sockets, as it waits for the
+// "connection established" event, which datagram sockets never emit. Instead the first burst is sent right when
+// the application starts and the following ones are scheduled every UdpInterval ms. The sink tells us when all
+// data has arrived, which stops the bursts immediately.
+
+#include <algorithm>
+#include "ns3/log.h"
+#include "ns3/socket.h"
+#include "ns3/simulator.h"
+#include "ns3/packet.h"
+#include "ns3/uinteger.h"
+#include "ns3/udp-socket-factory.h"
+#include "udp-bulk-send-application.h"
+
+namespace ns3 {
+
+    NS_LOG_COMPONENT_DEFINE ("UdpBulkSendApplication");
+
+    NS_OBJECT_ENSURE_REGISTERED (UdpBulkSendApplication);
+
+    TypeId
+    UdpBulkSendApplication::GetTypeId(void) {
+        static TypeId tid = TypeId("ns3::UdpBulkSendApplication")
+                .SetParent<CustomBulkSendApplication>()
+                .SetGroupName("Applications")
+                .AddConstructor<UdpBulkSendApplication>()
+                .AddAttribute("UdpInterval",
+                              "Resend packets every x ms",
+                              UintegerValue(100),
+                              MakeUintegerAccessor(&UdpBulkSendApplication::m_udpInterval),
+                              MakeUintegerChecker<uint32_t>())
+                .AddAttribute("UdpCount",
+                              "Send x packets every timeframe",
+                              UintegerValue(100),
+                              MakeUintegerAccessor(&UdpBulkSendApplication::m_udpCount),
+                              MakeUintegerChecker<uint32_t>());
+        return tid;
+    }
+
+
+    UdpBulkSendApplication::UdpBulkSendApplication()
+            : m_udpInterval(100),
+              m_udpCount(100),
+              m_rxBytes(0),
+              m_finished(false) {
+        NS_LOG_FUNCTION (this);
+    }
+
+    UdpBulkSendApplication::~UdpBulkSendApplication() {
+        NS_LOG_FUNCTION (this);
+    }
+
+    void
+    UdpBulkSendApplication::AnnouncePacketsReceived(uint64_t rxcnt) {
+        NS_LOG_FUNCTION (this << rxcnt);
+        m_rxBytes = rxcnt;
+        if (m_maxBytes > 0 && m_rxBytes >= m_maxBytes) {
+            Finish();
+        }
+    }
+
+// Application Methods
+    void UdpBulkSendApplication::StartApplication(void) // Called at time specified by Start
+    {
+        NS_LOG_FUNCTION (this);
+
+        if (m_finished) {
+            return;
+        }
+        // Create the socket if not already
+        if (!m_socket) {
+            m_socket = CreateConnectedSocket();
+            if (m_socket->GetSocketType() != Socket::NS3_SOCK_DGRAM) {
+                NS_FATAL_ERROR ("UdpBulkSendApplication needs a datagram socket, streams are sent by TcpBulkSendApplication");
+            }
+        }
+
+        // There is no connection to wait for
+        if (m_traceFile.empty()) {
+            SendBurst();
+        } else {
+            StartReplay();
+        }
+    }
+
+    void UdpBulkSendApplication::StopApplication(void) // Called at time specified by Stop
+    {
+        NS_LOG_FUNCTION (this);
+
+        m_sendEvent.Cancel();
+        CustomBulkSendApplication::StopApplication();
+    }
+
+
+// Private helpers
+
+    void UdpBulkSendApplication::SendBurst(void) {
+        NS_LOG_FUNCTION (this);
+
+        for (uint32_t i = 0; i < m_udpCount; ++i) {
+            Ptr<Packet> packet = Create<Packet>(m_sendSize);
+            // Fails if the device queue is full, the rest of the burst would be dropped as well
+            if (m_socket->Send(packet) <= 0) {
+                SendFailed(m_sendSize);
+                break;
+            }
+            m_totBytes += m_sendSize;
+            m_txTrace(packet);
+        }
+        m_sendEvent = Simulator::Schedule(MilliSeconds(m_udpInterval), &UdpBulkSendApplication::SendBurst, this);
+    }
+
+    void UdpBulkSendApplication::ReplayTraceRecord(void) {
+        NS_LOG_FUNCTION (this);
+
+        uint64_t toSend = m_traceSize;
+        if (m_maxBytes > 0) {
+            toSend = std::min(toSend, m_maxBytes - m_totBytes);
+        }
+
+        Ptr<Packet> packet = Create<Packet>(toSend);
+        if (m_socket->Send(packet) > 0) {
+            m_totBytes += toSend;
+            m_txTrace(packet);
+        } else {
+            SendFailed(toSend);
+        }
+
+        if ((m_maxBytes == 0 || m_totBytes < m_maxBytes) && ReadTraceRecord()) {
+            ScheduleReplay();
+            return;
+        }
+
+        // Trace finished (or MaxBytes sent)
+        m_traceDone = true;
+        Finish();
+        NS_LOG_INFO("Trace replayed at " << Simulator::Now());
+    }
+
+    uint32_t UdpBulkSendApplication::GetMaxRecordSize(void) const {
+        // 65535 bytes minus the IPv4 (20) and UDP (8) headers
+        return 65507;
+    }
+
+    void UdpBulkSendApplication::Finish(void) {
+        if (m_finished) {
+            return;
+        }
+        m_finished = true;
+        m_sendEvent.Cancel();
+        m_replayEvent.Cancel();
+        if (m_socket) {
+            m_socket->Close();
+        }
+        NS_LOG_INFO("All packets sent at " << Simulator::Now());
+    }
+
+} // Namespace ns3
@@ -0,0 +1,92 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2010 Georgia Institute of Technology
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: George F. Riley <riley@ece.gatech.edu>
+ */
+
+#ifndef UDP_BULK_SEND_APPLICATION_H
+#define UDP_BULK_SEND_APPLICATION_H
+
+#include "custom-bulk-send-application.h"
+
+namespace ns3 {
+
+/**
+ * \ingroup bulksend
+ *
+ * \brief Send bursts of datagrams until the receiver has got MaxBytes.
+ *
+ * Datagram sockets have neither connections nor a send buffer which signals
+ * free space, so the application sends UdpCount datagrams of SendSize bytes
+ * every UdpInterval ms, starting as soon as it is started. It does not know
+ * which datagrams have been lost, so it keeps sending until the receiver
+ * announces (AnnouncePacketsReceived) that MaxBytes have arrived. With
+ * MaxBytes zero it sends until it is stopped.
+ *
+ * A replayed trace is sent as it is, without retransmitting lost datagrams.
+ */
+    class UdpBulkSendApplication : public CustomBulkSendApplication {
+    public:
+        /**
+         * \brief Get the type ID.
+         * \return the object TypeId
+         */
+        static TypeId GetTypeId(void);
+
+        UdpBulkSendApplication();
+
+        virtual ~UdpBulkSendApplication();
+
+        /**
+         * \brief Stop sending as soon as the receiver has got MaxBytes.
+         * \param rxcnt the number of bytes received
+         */
+        virtual void AnnouncePacketsReceived(uint64_t rxcnt);
+
+    private:
+        // inherited from Application base class.
+        virtual void StartApplication(void);    // Called at time specified by Start
+        virtual void StopApplication(void);     // Called at time specified by Stop
+
+        /**
+         * \brief Send UdpCount datagrams and schedule the next burst.
+         */
+        void SendBurst(void);
+
+        // inherited from CustomBulkSendApplication
+        virtual void ReplayTraceRecord(void);
+
+        /**
+         * \return the largest UDP payload of an IPv4 datagram (65507 bytes)
+         */
+        virtual uint32_t GetMaxRecordSize(void) const;
+
+        /**
+         * \brief Stop sending and close the socket.
+         */
+        void Finish(void);
+
+        uint32_t m_udpInterval;     //!< Time between two bursts in ms
+        uint32_t m_udpCount;        //!< Datagrams per burst
+        uint64_t m_rxBytes;         //!< Bytes the receiver has announced
+        bool m_finished;            //!< True once the receiver has got MaxBytes
+        EventId m_sendEvent;        //!< Event to send the next burst
+    };
+
+} // namespace ns3
+
+#endif /* UDP_BULK_SEND_APPLICATION_H */
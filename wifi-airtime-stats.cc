@@ -0,0 +1,191 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// Kommunikation in verteilten Systemen - Airtime accounting
+// Every WifiPhy logs the periods it spends in a certain state (TX, RX, CCA_BUSY, IDLE, ...)
+// through the "State" trace source of its WifiPhyStateHelper. We simply sum up those periods per PHY
+// and add up the PHYs of a node (relays with one radio per hop) and of a channel when printing.
+// The callback is bound to the counters of the PHY directly, so there is no need to parse the
+// trace context string for every state change.
+
+#include <algorithm>
+#include <map>
+#include "ns3/log.h"
+#include "ns3/callback.h"
+#include "ns3/node.h"
+#include "ns3/pointer.h"
+#include "ns3/wifi-net-device.h"
+#include "ns3/wifi-phy.h"
+#include "ns3/wifi-phy-state-helper.h"
+#include "wifi-airtime-stats.h"
+
+namespace ns3 {
+
+    NS_LOG_COMPONENT_DEFINE ("WifiAirtimeStats");
+
+    WifiAirtimeStats::WifiAirtimeStats() {
+        m_window.start = Seconds(0);
+        m_window.end = Time::Max();
+    }
+
+    void
+    WifiAirtimeStats::Install(NetDeviceContainer devices) {
+        NS_ASSERT_MSG (m_phys.empty(), "WifiAirtimeStats::Install must only be called once");
+
+        // The trace sinks get pointers into m_phys, so it must not be resized afterwards
+        m_phys.resize(devices.GetN());
+        for (uint32_t i = 0; i < devices.GetN(); ++i) {
+            Ptr<WifiNetDevice> device = DynamicCast<WifiNetDevice>(devices.Get(i));
+            NS_ASSERT_MSG (device, "WifiAirtimeStats can only be installed on WifiNetDevices");
+
+            PhyAirtime &airtime = m_phys[i];
+            airtime.window = &m_window;
+            airtime.phy = device->GetPhy();
+            airtime.nodeId = device->GetNode()->GetId();
+
+            PointerValue state;
+            device->GetPhy()->GetAttribute("State", state);
+            state.Get<WifiPhyStateHelper>()->TraceConnectWithoutContext(
+                    "State", MakeBoundCallback(&WifiAirtimeStats::StateChanged, &airtime));
+        }
+    }
+
+    void
+    WifiAirtimeStats::SetWindowStart(Time start) {
+        m_window.start = start;
+    }
+
+    void
+    WifiAirtimeStats::SetWindowEnd(Time end) {
+        m_window.end = end;
+    }
+
+    void
+    WifiAirtimeStats::StateChanged(PhyAirtime *airtime, Time start, Time duration, WifiPhyState state) {
+        // Only account for the part of the period which lies inside the measurement window
+        Time end = std::min(start + duration, airtime->window->end);
+        start = std::max(start, airtime->window->start);
+        if (end <= start) {
+            return;
+        }
+        duration = end - start;
+
+        switch (state) {
+            case WifiPhyState::TX:
+                airtime->tx += duration;
+                break;
+            case WifiPhyState::RX:
+                airtime->rx += duration;
+                break;
+            case WifiPhyState::CCA_BUSY:
+                airtime->ccaBusy += duration;
+                break;
+            case WifiPhyState::IDLE:
+                airtime->idle += duration;
+                break;
+            default:
+                airtime->other += duration;
+                break;
+        }
+    }
+
+    void
+    WifiAirtimeStats::PrintJson(std::ostream &os, Time end) const {
+        end = std::min(end, m_window.end);
+        Time length = std::max(end - m_window.start, Seconds(0));
+        double window = length.IsStrictlyPositive() ? length.GetSeconds() : 1.0;
+
+        // Airtime of a node or a channel, summed up over its PHYs
+        struct Sum {
+            uint32_t phys;  //!< Number of PHYs
+            Time tx;        //!< Time spent transmitting
+            Time rx;        //!< Time spent receiving
+            Time ccaBusy;   //!< Time the medium was sensed busy
+            Time idle;      //!< Idle time, including the period running at the end of the window
+        };
+        std::vector<uint32_t> nodeOrder;
+        std::map<uint32_t, Sum> nodes;
+        std::map<uint16_t, Sum> channels;
+        for (std::vector<PhyAirtime>::const_iterator i = m_phys.begin(); i != m_phys.end(); ++i) {
+            Time busy = i->tx + i->rx + i->ccaBusy;
+            // The idle period running at the end of the window has not been reported yet
+            Time idle = std::max(length - busy - i->other, i->idle);
+
+            if (nodes.find(i->nodeId) == nodes.end()) {
+                nodeOrder.push_back(i->nodeId);
+            }
+            Sum &node = nodes[i->nodeId];
+            Sum &channel = channels[i->phy->GetChannelNumber()];
+            Sum *sums[] = {&node, &channel};
+            for (uint32_t k = 0; k < 2; ++k) {
+                Sum *sum = sums[k];
+                sum->phys++;
+                sum->tx += i->tx;
+                sum->rx += i->rx;
+                sum->ccaBusy += i->ccaBusy;
+                sum->idle += idle;
+            }
+        }
+
+        double maxBusy = 0.0;
+        os << "{\"window_ms\":" << length.GetMilliSeconds() << ",\"nodes\":[";
+        for (std::vector<uint32_t>::const_iterator i = nodeOrder.begin(); i != nodeOrder.end(); ++i) {
+            const Sum &node = nodes[*i];
+            // Relays with several radios can be busy on all of them at once, so use the mean over the radios
+            double utilisation = (node.tx + node.rx + node.ccaBusy).GetSeconds() / (window * node.phys);
+            maxBusy = std::max(maxBusy, utilisation);
+
+            if (i != nodeOrder.begin()) {
+                os << ",";
+            }
+            os << "{";
+            os << "\"node\":" << *i << ",";
+            os << "\"radios\":" << node.phys << ",";
+            os << "\"tx_ms\":" << node.tx.GetMilliSeconds() << ",";
+            os << "\"rx_ms\":" << node.rx.GetMilliSeconds() << ",";
+            os << "\"cca_busy_ms\":" << node.ccaBusy.GetMilliSeconds() << ",";
+            os << "\"idle_ms\":" << node.idle.GetMilliSeconds() << ",";
+            os << "\"utilisation\":" << utilisation;
+            os << "}";
+        }
+        os << "],";
+
+        // The nodes on one channel share it. As long as there are no collisions, transmissions do not
+        // overlap and the sum of the TX periods on a channel is the time the channel was occupied.
+        Time busiestTx;
+        os << "\"channels\":[";
+        for (std::map<uint16_t, Sum>::const_iterator i = channels.begin(); i != channels.end(); ++i) {
+            busiestTx = std::max(busiestTx, i->second.tx);
+            if (i != channels.begin()) {
+                os << ",";
+            }
+            os << "{";
+            os << "\"channel\":" << i->first << ",";
+            os << "\"phys\":" << i->second.phys << ",";
+            os << "\"tx_ms\":" << i->second.tx.GetMilliSeconds() << ",";
+            os << "\"utilisation\":" << std::min(1.0, i->second.tx.GetSeconds() / window);
+            os << "}";
+        }
+        os << "],";
+
+        // With several channels these are the values of the busiest one
+        os << "\"channel_tx_ms\":" << busiestTx.GetMilliSeconds() << ",";
+        os << "\"channel_utilisation\":" << std::min(1.0, busiestTx.GetSeconds() / window) << ",";
+        os << "\"max_node_utilisation\":" << maxBusy;
+        os << "}";
+    }
+
+} // namespace ns3
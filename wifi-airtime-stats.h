@@ -0,0 +1,111 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef WIFI_AIRTIME_STATS_H
+#define WIFI_AIRTIME_STATS_H
+
+#include <ostream>
+#include <vector>
+#include "ns3/nstime.h"
+#include "ns3/net-device-container.h"
+#include "ns3/wifi-phy.h"
+#include "ns3/wifi-phy-state.h"
+
+namespace ns3 {
+
+/**
+ * \brief Per-node airtime accounting based on the WifiPhy state trace.
+ *
+ * Every PHY state period (TX, RX, CCA busy, idle, ...) reported by the
+ * WifiPhyStateHelper "State" trace source is added to the counters of the
+ * PHY it belongs to. Only the part of a period lying inside the measurement
+ * window is counted. The time not covered by any reported period (e.g. the
+ * idle period still running when the window closes) is reported as idle.
+ *
+ * The PHYs of a node with several radios are reported as one node, the
+ * channel utilisation is reported per channel number.
+ */
+    class WifiAirtimeStats {
+    public:
+        WifiAirtimeStats();
+
+        /**
+         * Connect to the PHY state trace of every WifiNetDevice in the container.
+         * Must be called once, before the simulation is started.
+         *
+         * \param devices the wifi devices to account airtime for
+         */
+        void Install(NetDeviceContainer devices);
+
+        /**
+         * Set the beginning of the measurement window (default: 0s).
+         *
+         * \param start the beginning of the measurement window
+         */
+        void SetWindowStart(Time start);
+
+        /**
+         * Close the measurement window. Can be called while the simulation is running,
+         * e.g. as soon as the transfer under test has finished.
+         *
+         * \param end the end of the measurement window
+         */
+        void SetWindowEnd(Time end);
+
+        /**
+         * Print the airtime of every node and the resulting utilisation of every channel as JSON object.
+         *
+         * \param os the stream to print to
+         * \param end the time the simulation stopped; used if the window was not closed before
+         */
+        void PrintJson(std::ostream &os, Time end) const;
+
+    private:
+        /// The measurement window shared by all PHYs
+        struct Window {
+            Time start;     //!< Beginning of the measurement window
+            Time end;       //!< End of the measurement window
+        };
+
+        /// Airtime counters of a single PHY
+        struct PhyAirtime {
+            const Window *window;   //!< The measurement window
+            Ptr<WifiPhy> phy;   //!< The PHY, asked for its channel number when printing
+            uint32_t nodeId;    //!< Node the PHY belongs to
+            Time tx;            //!< Time spent transmitting
+            Time rx;            //!< Time spent receiving
+            Time ccaBusy;       //!< Time the medium was sensed busy
+            Time idle;          //!< Reported idle time
+            Time other;         //!< Switching, sleeping, off
+        };
+
+        /**
+         * Trace sink for the WifiPhyStateHelper "State" trace source.
+         *
+         * \param airtime the counters of the PHY the trace belongs to
+         * \param start the start of the state period
+         * \param duration the duration of the state period
+         * \param state the state of the PHY during the period
+         */
+        static void StateChanged(PhyAirtime *airtime, Time start, Time duration, WifiPhyState state);
+
+        std::vector<PhyAirtime> m_phys; //!< Counters, one entry per installed device
+        Window m_window;                //!< The measurement window
+    };
+
+} // namespace ns3
+
+#endif /* WIFI_AIRTIME_STATS_H */
@@ -0,0 +1,176 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// Kommunikation in verteilten Systemen - Collision accounting
+// A hidden terminal shows up twice: The receiver in the middle can not decode the overlapping frames (RxError),
+// and the sender does not get an ACK (MacTxDataFailed) and retransmits. With RTS/CTS, the collisions move to
+// the short RTS frames (MacTxRtsFailed).
+
+#include "ns3/log.h"
+#include "ns3/callback.h"
+#include "ns3/node.h"
+#include "ns3/pointer.h"
+#include "ns3/simulator.h"
+#include "ns3/wifi-net-device.h"
+#include "ns3/wifi-phy.h"
+#include "ns3/wifi-phy-state-helper.h"
+#include "ns3/wifi-remote-station-manager.h"
+#include "wifi-collision-stats.h"
+
+namespace ns3 {
+
+    NS_LOG_COMPONENT_DEFINE ("WifiCollisionStats");
+
+    WifiCollisionStats::WifiCollisionStats() {
+        m_window.start = Seconds(0);
+        m_window.end = Time::Max();
+    }
+
+    void
+    WifiCollisionStats::Install(NetDeviceContainer devices) {
+        NS_ASSERT_MSG (m_devices.empty(), "WifiCollisionStats::Install must only be called once");
+
+        // The trace sinks get pointers into m_devices, so it must not be resized afterwards
+        m_devices.resize(devices.GetN());
+        for (uint32_t i = 0; i < devices.GetN(); ++i) {
+            Ptr<WifiNetDevice> device = DynamicCast<WifiNetDevice>(devices.Get(i));
+            NS_ASSERT_MSG (device, "WifiCollisionStats can only be installed on WifiNetDevices");
+
+            DeviceCounters &counters = m_devices[i];
+            counters.window = &m_window;
+            counters.nodeId = device->GetNode()->GetId();
+            counters.txFrames = 0;
+            counters.rxOk = 0;
+            counters.rxError = 0;
+            counters.rxDrop = 0;
+            counters.rtsFailed = 0;
+            counters.dataFailed = 0;
+            counters.finalRtsFailed = 0;
+            counters.finalDataFailed = 0;
+
+            Ptr<WifiPhy> phy = device->GetPhy();
+            phy->TraceConnectWithoutContext("PhyTxBegin", MakeBoundCallback(&WifiCollisionStats::PhyTxBegin, &counters));
+            phy->TraceConnectWithoutContext("PhyRxDrop", MakeBoundCallback(&WifiCollisionStats::PhyRxDrop, &counters));
+
+            PointerValue state;
+            phy->GetAttribute("State", state);
+            Ptr<WifiPhyStateHelper> stateHelper = state.Get<WifiPhyStateHelper>();
+            stateHelper->TraceConnectWithoutContext("RxOk", MakeBoundCallback(&WifiCollisionStats::RxOk, &counters));
+            stateHelper->TraceConnectWithoutContext("RxError", MakeBoundCallback(&WifiCollisionStats::RxError, &counters));
+
+            Ptr<WifiRemoteStationManager> manager = device->GetRemoteStationManager();
+            manager->TraceConnectWithoutContext(
+                    "MacTxRtsFailed", MakeBoundCallback(&WifiCollisionStats::Failed, &counters.rtsFailed, &m_window));
+            manager->TraceConnectWithoutContext(
+                    "MacTxDataFailed", MakeBoundCallback(&WifiCollisionStats::Failed, &counters.dataFailed, &m_window));
+            manager->TraceConnectWithoutContext(
+                    "MacTxFinalRtsFailed", MakeBoundCallback(&WifiCollisionStats::Failed, &counters.finalRtsFailed, &m_window));
+            manager->TraceConnectWithoutContext(
+                    "MacTxFinalDataFailed", MakeBoundCallback(&WifiCollisionStats::Failed, &counters.finalDataFailed, &m_window));
+        }
+    }
+
+    void
+    WifiCollisionStats::SetWindowStart(Time start) {
+        m_window.start = start;
+    }
+
+    void
+    WifiCollisionStats::SetWindowEnd(Time end) {
+        m_window.end = end;
+    }
+
+    bool
+    WifiCollisionStats::InWindow(const DeviceCounters *counters) {
+        Time now = Simulator::Now();
+        return now >= counters->window->start && now < counters->window->end;
+    }
+
+    void
+    WifiCollisionStats::PhyTxBegin(DeviceCounters *counters, Ptr<const Packet> packet) {
+        if (InWindow(counters)) {
+            counters->txFrames++;
+        }
+    }
+
+    void
+    WifiCollisionStats::PhyRxDrop(DeviceCounters *counters, Ptr<const Packet> packet) {
+        if (InWindow(counters)) {
+            counters->rxDrop++;
+        }
+    }
+
+    void
+    WifiCollisionStats::RxOk(DeviceCounters *counters, Ptr<const Packet> packet, double snr, WifiMode mode,
+                             WifiPreamble preamble) {
+        if (InWindow(counters)) {
+            counters->rxOk++;
+        }
+    }
+
+    void
+    WifiCollisionStats::RxError(DeviceCounters *counters, Ptr<const Packet> packet, double snr) {
+        if (InWindow(counters)) {
+            counters->rxError++;
+        }
+    }
+
+    void
+    WifiCollisionStats::Failed(uint64_t *counter, const Window *window, Mac48Address address) {
+        Time now = Simulator::Now();
+        if (now >= window->start && now < window->end) {
+            (*counter)++;
+        }
+    }
+
+    void
+    WifiCollisionStats::PrintJson(std::ostream &os) const {
+        uint64_t rxError = 0;
+        uint64_t rxDrop = 0;
+        uint64_t retransmissions = 0;
+        uint64_t finalFailed = 0;
+
+        os << "{\"nodes\":[";
+        for (std::vector<DeviceCounters>::const_iterator i = m_devices.begin(); i != m_devices.end(); ++i) {
+            rxError += i->rxError;
+            rxDrop += i->rxDrop;
+            retransmissions += i->rtsFailed + i->dataFailed;
+            finalFailed += i->finalRtsFailed + i->finalDataFailed;
+
+            if (i != m_devices.begin()) {
+                os << ",";
+            }
+            os << "{";
+            os << "\"node\":" << i->nodeId << ",";
+            os << "\"tx_frames\":" << i->txFrames << ",";
+            os << "\"rx_ok\":" << i->rxOk << ",";
+            os << "\"rx_error\":" << i->rxError << ",";
+            os << "\"rx_drop\":" << i->rxDrop << ",";
+            os << "\"rts_failed\":" << i->rtsFailed << ",";
+            os << "\"data_failed\":" << i->dataFailed << ",";
+            os << "\"final_rts_failed\":" << i->finalRtsFailed << ",";
+            os << "\"final_data_failed\":" << i->finalDataFailed;
+            os << "}";
+        }
+        os << "],";
+        os << "\"rx_error\":" << rxError << ",";
+        os << "\"rx_drop\":" << rxDrop << ",";
+        os << "\"retransmissions\":" << retransmissions << ",";
+        os << "\"final_failed\":" << finalFailed;
+        os << "}";
+    }
+
+} // namespace ns3
@@ -0,0 +1,153 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef WIFI_COLLISION_STATS_H
+#define WIFI_COLLISION_STATS_H
+
+#include <ostream>
+#include <vector>
+#include "ns3/nstime.h"
+#include "ns3/packet.h"
+#include "ns3/mac48-address.h"
+#include "ns3/wifi-mode.h"
+#include "ns3/wifi-preamble.h"
+#include "ns3/net-device-container.h"
+
+namespace ns3 {
+
+/**
+ * \brief Per-node collision and retransmission accounting.
+ *
+ * On the receiving side, frames which could not be decoded (RxError, mostly
+ * caused by interference of overlapping transmissions) and frames dropped because
+ * the PHY was busy with another frame or transmitting (PhyRxDrop) are counted.
+ * On the sending side, the failed RTS and data transmissions reported by the
+ * remote station manager are counted. Every failure leads to a retransmission,
+ * unless the retry limit has been reached (final failure, the frame is dropped).
+ */
+    class WifiCollisionStats {
+    public:
+        WifiCollisionStats();
+
+        /**
+         * Connect to the PHY and remote station manager traces of every WifiNetDevice in the container.
+         * Must be called once, before the simulation is started.
+         *
+         * \param devices the wifi devices to account collisions for
+         */
+        void Install(NetDeviceContainer devices);
+
+        /**
+         * Set the beginning of the measurement window (default: 0s).
+         *
+         * \param start the beginning of the measurement window
+         */
+        void SetWindowStart(Time start);
+
+        /**
+         * Close the measurement window. Can be called while the simulation is running.
+         *
+         * \param end the end of the measurement window
+         */
+        void SetWindowEnd(Time end);
+
+        /**
+         * Print the counters of every node and their sums as JSON object.
+         *
+         * \param os the stream to print to
+         */
+        void PrintJson(std::ostream &os) const;
+
+    private:
+        /// The measurement window shared by all devices
+        struct Window {
+            Time start;     //!< Beginning of the measurement window
+            Time end;       //!< End of the measurement window
+        };
+
+        /// Counters of a single device
+        struct DeviceCounters {
+            const Window *window;       //!< The measurement window
+            uint32_t nodeId;            //!< Node the device belongs to
+            uint64_t txFrames;          //!< Frames transmitted, including control frames and retransmissions
+            uint64_t rxOk;              //!< Frames received successfully
+            uint64_t rxError;           //!< Frames which could not be decoded
+            uint64_t rxDrop;            //!< Frames dropped because the PHY was busy
+            uint64_t rtsFailed;         //!< RTS frames not answered by a CTS
+            uint64_t dataFailed;        //!< Data frames not acknowledged
+            uint64_t finalRtsFailed;    //!< RTS frames given up after the retry limit
+            uint64_t finalDataFailed;   //!< Data frames given up after the retry limit
+        };
+
+        /**
+         * \param counters the counters of a device
+         * \return true if the current time lies inside the measurement window
+         */
+        static bool InWindow(const DeviceCounters *counters);
+
+        /**
+         * Trace sink for the WifiPhy "PhyTxBegin" trace source.
+         *
+         * \param counters the counters of the device
+         * \param packet the transmitted frame
+         */
+        static void PhyTxBegin(DeviceCounters *counters, Ptr<const Packet> packet);
+
+        /**
+         * Trace sink for the WifiPhy "PhyRxDrop" trace source.
+         *
+         * \param counters the counters of the device
+         * \param packet the dropped frame
+         */
+        static void PhyRxDrop(DeviceCounters *counters, Ptr<const Packet> packet);
+
+        /**
+         * Trace sink for the WifiPhyStateHelper "RxOk" trace source.
+         *
+         * \param counters the counters of the device
+         * \param packet the received frame
+         * \param snr the signal to noise ratio of the frame
+         * \param mode the mode the frame was sent with
+         * \param preamble the preamble of the frame
+         */
+        static void RxOk(DeviceCounters *counters, Ptr<const Packet> packet, double snr, WifiMode mode,
+                         WifiPreamble preamble);
+
+        /**
+         * Trace sink for the WifiPhyStateHelper "RxError" trace source.
+         *
+         * \param counters the counters of the device
+         * \param packet the frame which could not be decoded
+         * \param snr the signal to noise ratio of the frame
+         */
+        static void RxError(DeviceCounters *counters, Ptr<const Packet> packet, double snr);
+
+        /**
+         * Trace sink for the failure trace sources of the WifiRemoteStationManager.
+         *
+         * \param counter the counter to increment
+         * \param window the measurement window
+         * \param address the address of the remote station
+         */
+        static void Failed(uint64_t *counter, const Window *window, Mac48Address address);
+
+        std::vector<DeviceCounters> m_devices;  //!< Counters, one entry per installed device
+        Window m_window;                        //!< The measurement window
+    };
+
+} // namespace ns3
+
+#endif /* WIFI_COLLISION_STATS_H */
@@ -0,0 +1,140 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// Kommunikation in verteilten Systemen - Energy accounting
+// Every node gets a battery (BasicEnergySource), every wifi device a WifiRadioEnergyModel which draws
+// the current of its PHY state (TX, RX, idle, ...) from the battery of its node. Relays with several radios
+// (multi channel topology) drain one battery. The batteries are sampled at the start and at the end of the
+// measurement window, so the energy spent while routing is settling is not accounted to the transfer.
+
+#include <algorithm>
+#include <map>
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+#include "ns3/node.h"
+#include "ns3/double.h"
+#include "ns3/basic-energy-source-helper.h"
+#include "ns3/wifi-radio-energy-model-helper.h"
+#include "wifi-energy-stats.h"
+
+namespace ns3 {
+
+    NS_LOG_COMPONENT_DEFINE ("WifiEnergyStats");
+
+    WifiEnergyStats::WifiEnergyStats()
+            : m_initialEnergy(0.0),
+              m_voltage(0.0),
+              m_start(Seconds(0)),
+              m_closed(false) {
+    }
+
+    void
+    WifiEnergyStats::Install(NetDeviceContainer devices, double initialEnergy, double voltage) {
+        NS_ASSERT_MSG (m_nodes.empty(), "WifiEnergyStats::Install must only be called once");
+        m_initialEnergy = initialEnergy;
+        m_voltage = voltage;
+
+        BasicEnergySourceHelper sourceHelper;
+        sourceHelper.Set("BasicEnergySourceInitialEnergyJ", DoubleValue(initialEnergy));
+        sourceHelper.Set("BasicEnergySupplyVoltageV", DoubleValue(voltage));
+        WifiRadioEnergyModelHelper radioHelper;
+
+        // One source per node, shared by all of its radios
+        std::map<uint32_t, Ptr<EnergySource> > sources;
+        for (uint32_t i = 0; i < devices.GetN(); ++i) {
+            Ptr<NetDevice> device = devices.Get(i);
+            Ptr<Node> node = device->GetNode();
+            Ptr<EnergySource> &source = sources[node->GetId()];
+            if (!source) {
+                source = sourceHelper.Install(node).Get(0);
+                NodeEnergy energy;
+                energy.source = source;
+                energy.nodeId = node->GetId();
+                energy.start = initialEnergy;
+                energy.end = initialEnergy;
+                m_nodes.push_back(energy);
+            }
+            radioHelper.Install(device, source);
+        }
+    }
+
+    void
+    WifiEnergyStats::SetWindowStart(Time start) {
+        m_start = start;
+        Simulator::Schedule(start - Simulator::Now(), &WifiEnergyStats::OpenWindow, this);
+    }
+
+    void
+    WifiEnergyStats::OpenWindow(void) {
+        if (m_closed) {
+            return;
+        }
+        for (std::vector<NodeEnergy>::iterator i = m_nodes.begin(); i != m_nodes.end(); ++i) {
+            i->start = i->source->GetRemainingEnergy();
+        }
+    }
+
+    void
+    WifiEnergyStats::CloseWindow(void) {
+        if (m_closed) {
+            return;
+        }
+        m_closed = true;
+        m_end = Simulator::Now();
+        // GetRemainingEnergy updates the source with the current drawn since the last state change
+        for (std::vector<NodeEnergy>::iterator i = m_nodes.begin(); i != m_nodes.end(); ++i) {
+            i->end = i->source->GetRemainingEnergy();
+        }
+    }
+
+    void
+    WifiEnergyStats::PrintJson(std::ostream &os, uint64_t rxBytes) const {
+        Time length = m_closed ? std::max(m_end - m_start, Seconds(0)) : Seconds(0);
+
+        double total = 0.0;
+        double maxNode = 0.0;
+        double minRemaining = m_initialEnergy;
+
+        os << "{\"initial_j\":" << m_initialEnergy << ",";
+        os << "\"voltage_v\":" << m_voltage << ",";
+        os << "\"window_ms\":" << length.GetMilliSeconds() << ",\"nodes\":[";
+        for (std::vector<NodeEnergy>::const_iterator i = m_nodes.begin(); i != m_nodes.end(); ++i) {
+            double consumed = i->start - i->end;
+            total += consumed;
+            maxNode = std::max(maxNode, consumed);
+            minRemaining = std::min(minRemaining, i->end);
+
+            if (i != m_nodes.begin()) {
+                os << ",";
+            }
+            os << "{";
+            os << "\"node\":" << i->nodeId << ",";
+            os << "\"energy_j\":" << consumed << ",";
+            os << "\"remaining_j\":" << i->end << ",";
+            os << "\"power_w\":" << (length.IsStrictlyPositive() ? consumed / length.GetSeconds() : 0.0);
+            os << "}";
+        }
+        os << "],";
+
+        os << "\"energy_j\":" << total << ",";
+        // The node spending most energy is the one whose battery runs out first
+        os << "\"max_node_energy_j\":" << maxNode << ",";
+        os << "\"min_remaining_j\":" << minRemaining << ",";
+        os << "\"j_per_bit\":" << (rxBytes > 0 ? total / (rxBytes * 8.0) : 0.0);
+        os << "}";
+    }
+
+} // namespace ns3
@@ -0,0 +1,100 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef WIFI_ENERGY_STATS_H
+#define WIFI_ENERGY_STATS_H
+
+#include <ostream>
+#include <vector>
+#include <stdint.h>
+#include "ns3/nstime.h"
+#include "ns3/net-device-container.h"
+#include "ns3/energy-source.h"
+
+namespace ns3 {
+
+/**
+ * \brief Per-node energy consumption of the wifi radios.
+ *
+ * Installs a BasicEnergySource on every node owning one of the devices and a
+ * WifiRadioEnergyModel on every device, drawing from the source of its node.
+ * The remaining energy of the sources is sampled when the measurement window
+ * opens and when it is closed, the difference is the energy consumed by the
+ * node. Dividing the sum by the bits delivered inside the window gives the
+ * energy per bit.
+ */
+    class WifiEnergyStats {
+    public:
+        WifiEnergyStats();
+
+        /**
+         * Install the energy sources and radio energy models.
+         * Must be called once, before the simulation is started.
+         *
+         * \param devices the wifi devices to account energy for
+         * \param initialEnergy the energy stored in the source of every node in J
+         * \param voltage the supply voltage of the sources in V
+         */
+        void Install(NetDeviceContainer devices, double initialEnergy, double voltage);
+
+        /**
+         * Open the measurement window at the given time (default: 0s).
+         * Must be called after Install, before the simulation is started.
+         *
+         * \param start the beginning of the measurement window
+         */
+        void SetWindowStart(Time start);
+
+        /**
+         * Close the measurement window now. Only the first call has an effect, so it can
+         * be called as soon as the transfer under test has finished and again once the
+         * simulation has stopped (before Simulator::Destroy).
+         */
+        void CloseWindow(void);
+
+        /**
+         * Print the energy consumed by every node and the energy per delivered bit as JSON object.
+         *
+         * \param os the stream to print to
+         * \param rxBytes the bytes delivered inside the measurement window
+         */
+        void PrintJson(std::ostream &os, uint64_t rxBytes) const;
+
+    private:
+        /// Energy source of a single node
+        struct NodeEnergy {
+            Ptr<EnergySource> source;   //!< The source all radios of the node draw from
+            uint32_t nodeId;            //!< Node the source belongs to
+            double start;               //!< Remaining energy when the window was opened in J
+            double end;                 //!< Remaining energy when the window was closed in J
+        };
+
+        /**
+         * Sample the remaining energy of every node at the beginning of the window.
+         */
+        void OpenWindow(void);
+
+        std::vector<NodeEnergy> m_nodes;    //!< One entry per node
+        double m_initialEnergy;             //!< Initial energy of every source in J
+        double m_voltage;                   //!< Supply voltage of the sources in V
+        Time m_start;                       //!< Beginning of the measurement window
+        Time m_end;                         //!< End of the measurement window
+        bool m_closed;                      //!< Whether the window has been closed
+    };
+
+} // namespace ns3
+
+#endif /* WIFI_ENERGY_STATS_H */
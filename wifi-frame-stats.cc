@@ -0,0 +1,205 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// Kommunikation in verteilten Systemen - Frame classification
+// The WifiPhyStateHelper of every PHY fires its "Tx" trace with the frame being sent and logs the
+// TX period of the same transmission through its "State" trace right afterwards. We classify the frame
+// in the first callback and add the duration to the class in the second one. Both callbacks are bound
+// to the PHY directly, so no context strings have to be parsed and no lookups are needed per frame.
+
+#include "ns3/log.h"
+#include "ns3/callback.h"
+#include "ns3/pointer.h"
+#include "ns3/wifi-net-device.h"
+#include "ns3/wifi-phy.h"
+#include "ns3/wifi-phy-state-helper.h"
+#include "ns3/wifi-mac-header.h"
+#include "ns3/amsdu-subframe-header.h"
+#include "ns3/llc-snap-header.h"
+#include "ns3/arp-l3-protocol.h"
+#include "ns3/ipv4-header.h"
+#include "ns3/ipv4-l3-protocol.h"
+#include "ns3/tcp-header.h"
+#include "ns3/tcp-l4-protocol.h"
+#include "ns3/udp-l4-protocol.h"
+#include "routing-overhead-stats.h"
+#include "wifi-frame-stats.h"
+
+namespace ns3 {
+
+    NS_LOG_COMPONENT_DEFINE ("WifiFrameStats");
+
+    // MPDUs inside an A-MPDU are preceded by a 4 byte delimiter whose last byte is this signature
+    static const uint8_t AMPDU_DELIMITER_SIGNATURE = 0x4E;
+
+    WifiFrameStats::WifiFrameStats() {
+        for (uint32_t i = 0; i < FRAME_CLASSES; ++i) {
+            m_classes[i].frames = 0;
+            m_classes[i].bytes = 0;
+        }
+    }
+
+    void
+    WifiFrameStats::Install(NetDeviceContainer devices) {
+        NS_ASSERT_MSG (m_phys.empty(), "WifiFrameStats::Install must only be called once");
+
+        // The trace sinks get pointers into m_phys, so it must not be resized afterwards
+        m_phys.resize(devices.GetN());
+        for (uint32_t i = 0; i < devices.GetN(); ++i) {
+            Ptr<WifiNetDevice> device = DynamicCast<WifiNetDevice>(devices.Get(i));
+            NS_ASSERT_MSG (device, "WifiFrameStats can only be installed on WifiNetDevices");
+
+            PhyTx &phy = m_phys[i];
+            phy.stats = this;
+            phy.frameClass = OTHER;
+            phy.hasClass = false;
+            phy.hasDuration = false;
+
+            PointerValue state;
+            device->GetPhy()->GetAttribute("State", state);
+            state.Get<WifiPhyStateHelper>()->TraceConnectWithoutContext(
+                    "Tx", MakeBoundCallback(&WifiFrameStats::Transmit, &phy));
+            state.Get<WifiPhyStateHelper>()->TraceConnectWithoutContext(
+                    "State", MakeBoundCallback(&WifiFrameStats::StateChanged, &phy));
+        }
+    }
+
+    WifiFrameStats::FrameClass
+    WifiFrameStats::Classify(Ptr<const Packet> frame) {
+        Ptr<Packet> copy = frame->Copy();
+
+        uint8_t delimiter[4];
+        if (copy->GetSize() > 4 && copy->CopyData(delimiter, 4) == 4 && delimiter[3] == AMPDU_DELIMITER_SIGNATURE) {
+            copy->RemoveAtStart(4);
+        }
+
+        WifiMacHeader macHeader;
+        copy->RemoveHeader(macHeader);
+        if (!macHeader.IsData()) {
+            return MAC_CONTROL;
+        }
+        if (macHeader.IsQosData() && macHeader.IsQosAmsdu()) {
+            // Classify an A-MSDU by its first MSDU
+            AmsduSubframeHeader amsduHeader;
+            copy->RemoveHeader(amsduHeader);
+        }
+
+        LlcSnapHeader llcHeader;
+        if (copy->GetSize() < llcHeader.GetSerializedSize()) {
+            // Null data frames
+            return MAC_CONTROL;
+        }
+        copy->RemoveHeader(llcHeader);
+        if (llcHeader.GetType() == ArpL3Protocol::PROT_NUMBER) {
+            return ARP;
+        }
+        if (llcHeader.GetType() != Ipv4L3Protocol::PROT_NUMBER) {
+            return OTHER;
+        }
+
+        Ipv4Header ipHeader;
+        copy->RemoveHeader(ipHeader);
+        switch (RoutingOverheadStats::ClassifyControl(ipHeader.GetProtocol(), copy)) {
+            case RoutingOverheadStats::NO_CONTROL:
+                break;
+            case RoutingOverheadStats::OLSR:
+                return OLSR_CONTROL;
+            default:
+                return ROUTING_OTHER;
+        }
+
+        if (ipHeader.GetProtocol() == TcpL4Protocol::PROT_NUMBER) {
+            TcpHeader tcpHeader;
+            copy->PeekHeader(tcpHeader);
+            uint32_t headerLength = tcpHeader.GetLength() * 4;
+            return ipHeader.GetPayloadSize() > headerLength ? TCP_DATA : TCP_ACK;
+        }
+        if (ipHeader.GetProtocol() == UdpL4Protocol::PROT_NUMBER) {
+            return UDP_DATA;
+        }
+        return OTHER;
+    }
+
+    const char *
+    WifiFrameStats::GetClassName(FrameClass frameClass) {
+        switch (frameClass) {
+            case OLSR_CONTROL:
+                return "olsr";
+            case ROUTING_OTHER:
+                return "routing_other";
+            case TCP_DATA:
+                return "tcp_data";
+            case TCP_ACK:
+                return "tcp_ack";
+            case UDP_DATA:
+                return "udp_data";
+            case ARP:
+                return "arp";
+            case MAC_CONTROL:
+                return "mac_control";
+            default:
+                return "other";
+        }
+    }
+
+    void
+    WifiFrameStats::Transmit(PhyTx *phy, Ptr<const Packet> packet, WifiMode mode, WifiPreamble preamble, uint8_t power) {
+        FrameClass frameClass = Classify(packet);
+        ClassCounters &counters = phy->stats->m_classes[frameClass];
+        counters.frames++;
+        counters.bytes += packet->GetSize();
+
+        if (phy->hasDuration) {
+            counters.airtime += phy->duration;
+            phy->hasDuration = false;
+        } else {
+            phy->frameClass = frameClass;
+            phy->hasClass = true;
+        }
+    }
+
+    void
+    WifiFrameStats::StateChanged(PhyTx *phy, Time start, Time duration, WifiPhyState state) {
+        if (state != WifiPhyState::TX) {
+            return;
+        }
+
+        if (phy->hasClass) {
+            phy->stats->m_classes[phy->frameClass].airtime += duration;
+            phy->hasClass = false;
+        } else {
+            phy->duration = duration;
+            phy->hasDuration = true;
+        }
+    }
+
+    void
+    WifiFrameStats::PrintJson(std::ostream &os) const {
+        os << "{";
+        for (uint32_t i = 0; i < FRAME_CLASSES; ++i) {
+            if (i > 0) {
+                os << ",";
+            }
+            os << "\"" << GetClassName(static_cast<FrameClass>(i)) << "\":{";
+            os << "\"frames\":" << m_classes[i].frames << ",";
+            os << "\"bytes\":" << m_classes[i].bytes << ",";
+            os << "\"airtime_us\":" << m_classes[i].airtime.GetMicroSeconds();
+            os << "}";
+        }
+        os << "}";
+    }
+
+} // namespace ns3
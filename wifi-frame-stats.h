@@ -0,0 +1,127 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef WIFI_FRAME_STATS_H
+#define WIFI_FRAME_STATS_H
+
+#include <ostream>
+#include <vector>
+#include "ns3/nstime.h"
+#include "ns3/packet.h"
+#include "ns3/net-device-container.h"
+#include "ns3/wifi-mode.h"
+#include "ns3/wifi-preamble.h"
+#include "ns3/wifi-phy-state.h"
+
+namespace ns3 {
+
+/**
+ * \brief Count frames, bytes and airtime of every frame transmitted by a WifiPhy, by protocol.
+ *
+ * Each frame handed to the PHY for transmission (including MAC retransmissions,
+ * ACKs and RTS/CTS) is classified once by looking at its MAC, LLC, IP and
+ * transport headers. Its airtime is taken from the TX period the PHY state
+ * helper logs for the same transmission.
+ */
+    class WifiFrameStats {
+    public:
+        /// The classes frames are sorted into
+        enum FrameClass {
+            OLSR_CONTROL,   //!< OLSR HELLO, TC, MID, HNA messages
+            ROUTING_OTHER,  //!< Control messages of AODV, DSDV and DSR
+            TCP_DATA,       //!< TCP segments carrying payload
+            TCP_ACK,        //!< TCP segments without payload (ACK, SYN, FIN)
+            UDP_DATA,       //!< Other UDP datagrams
+            ARP,            //!< ARP requests and replies
+            MAC_CONTROL,    //!< Control and management frames (ACK, RTS, CTS, Block ACK, ...)
+            OTHER,          //!< Everything else
+            FRAME_CLASSES   //!< Number of classes
+        };
+
+        WifiFrameStats();
+
+        /**
+         * Connect to the PHY traces of every WifiNetDevice in the container.
+         * Must be called once, before the simulation is started.
+         *
+         * \param devices the wifi devices to classify transmitted frames of
+         */
+        void Install(NetDeviceContainer devices);
+
+        /**
+         * Print frames, bytes and airtime of every class as JSON object.
+         *
+         * \param os the stream to print to
+         */
+        void PrintJson(std::ostream &os) const;
+
+        /**
+         * \param frame a frame as handed to the PHY, starting with its MAC header
+         * \return the class of the frame
+         */
+        static FrameClass Classify(Ptr<const Packet> frame);
+
+        /**
+         * \param frameClass a class of frames
+         * \return the name of the class as used inside the JSON output
+         */
+        static const char *GetClassName(FrameClass frameClass);
+
+    private:
+        /// Counters of a class of frames
+        struct ClassCounters {
+            uint64_t frames;    //!< Number of frames
+            uint64_t bytes;     //!< Bytes including MAC header and FCS
+            Time airtime;       //!< Time on air
+        };
+
+        /// A transmission of a PHY which has not been accounted yet
+        struct PhyTx {
+            WifiFrameStats *stats;  //!< The stats the PHY belongs to
+            FrameClass frameClass;  //!< Class of the frame being transmitted
+            bool hasClass;          //!< True if the frame has been classified, but the TX period is missing
+            Time duration;          //!< Duration of the transmission
+            bool hasDuration;       //!< True if the TX period is known, but the frame has not been classified
+        };
+
+        /**
+         * Trace sink for the WifiPhyStateHelper "Tx" trace source.
+         *
+         * \param phy the PHY which starts transmitting
+         * \param packet the frame
+         * \param mode the transmission mode
+         * \param preamble the preamble
+         * \param power the transmission power level
+         */
+        static void Transmit(PhyTx *phy, Ptr<const Packet> packet, WifiMode mode, WifiPreamble preamble, uint8_t power);
+
+        /**
+         * Trace sink for the WifiPhyStateHelper "State" trace source.
+         *
+         * \param phy the PHY the state period belongs to
+         * \param start the start of the state period
+         * \param duration the duration of the state period
+         * \param state the state of the PHY during the period
+         */
+        static void StateChanged(PhyTx *phy, Time start, Time duration, WifiPhyState state);
+
+        ClassCounters m_classes[FRAME_CLASSES]; //!< Counters, indexed by FrameClass
+        std::vector<PhyTx> m_phys;              //!< One entry per installed device
+    };
+
+} // namespace ns3
+
+#endif /* WIFI_FRAME_STATS_H */
@@ -0,0 +1,210 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// Kommunikation in verteilten Systemen - Wifi standard selection
+// The configuration follows the simple-ht-hidden-stations and vht-wifi-network examples:
+// HT/VHT (and QoS) are enabled by WifiHelper::SetStandard, the channel width and the aggregation
+// limits of the best effort access category are set on the installed devices.
+
+#include "ns3/log.h"
+#include "ns3/string.h"
+#include "ns3/uinteger.h"
+#include "ns3/wifi-net-device.h"
+#include "ns3/wifi-phy.h"
+#include "ns3/wifi-mac.h"
+#include "wifi-standard-helper.h"
+
+namespace ns3 {
+
+    NS_LOG_COMPONENT_DEFINE ("WifiStandardHelper");
+
+    WifiStandardHelper::WifiStandardHelper()
+            : m_standard("g"),
+              m_channelWidth(0),
+              m_maxAmpduSize(65535),
+              m_maxAmsduSize(0),
+              m_manager("minstrel"),
+              m_rtsCtsThreshold(65535) {
+    }
+
+    void
+    WifiStandardHelper::SetStandard(std::string standard) {
+        if (standard != "g" && standard != "n-2.4" && standard != "n-5" && standard != "ac") {
+            NS_FATAL_ERROR("Unknown wifi standard " << standard << ", use g, n-2.4, n-5 or ac");
+        }
+        m_standard = standard;
+    }
+
+    void
+    WifiStandardHelper::SetChannelWidth(uint16_t width) {
+        m_channelWidth = width;
+    }
+
+    void
+    WifiStandardHelper::SetAggregation(uint32_t maxAmpduSize, uint32_t maxAmsduSize) {
+        m_maxAmpduSize = maxAmpduSize;
+        m_maxAmsduSize = maxAmsduSize;
+    }
+
+    void
+    WifiStandardHelper::SetRateManager(std::string manager, std::string dataMode) {
+        if (manager != "minstrel" && manager != "constant") {
+            NS_FATAL_ERROR("Unknown rate manager " << manager << ", use minstrel or constant");
+        }
+        m_manager = manager;
+        m_dataMode = dataMode;
+    }
+
+    void
+    WifiStandardHelper::SetRtsCtsThreshold(uint32_t threshold) {
+        m_rtsCtsThreshold = threshold;
+    }
+
+    bool
+    WifiStandardHelper::IsHt(void) const {
+        return m_standard != "g";
+    }
+
+    uint16_t
+    WifiStandardHelper::GetChannelWidth(void) const {
+        if (m_channelWidth != 0) {
+            return m_channelWidth;
+        }
+        return m_standard == "ac" ? 80 : 20;
+    }
+
+    std::string
+    WifiStandardHelper::GetControlMode(void) const {
+        if (m_standard == "g") {
+            return "ErpOfdmRate6Mbps";
+        }
+        return m_standard == "ac" ? "VhtMcs0" : "HtMcs0";
+    }
+
+    double
+    WifiStandardHelper::GetFrequency(void) const {
+        if (m_standard == "n-5" || m_standard == "ac") {
+            // Channel 36, the default channel of the 5 GHz standards
+            return 5180.0 * 1e6;
+        }
+        return 2400.0 * 1e6;
+    }
+
+    void
+    WifiStandardHelper::Configure(WifiHelper &wifi) const {
+        uint16_t width = GetChannelWidth();
+        bool valid;
+        if (m_standard == "g") {
+            valid = width == 20;
+            wifi.SetStandard(WIFI_PHY_STANDARD_80211g);
+        } else if (m_standard == "n-2.4") {
+            valid = width == 20 || width == 40;
+            wifi.SetStandard(WIFI_PHY_STANDARD_80211n_2_4GHZ);
+        } else if (m_standard == "n-5") {
+            valid = width == 20 || width == 40;
+            wifi.SetStandard(WIFI_PHY_STANDARD_80211n_5GHZ);
+        } else {
+            valid = width == 20 || width == 40 || width == 80 || width == 160;
+            wifi.SetStandard(WIFI_PHY_STANDARD_80211ac);
+        }
+        if (!valid) {
+            NS_FATAL_ERROR("Channel width " << width << " MHz is not supported by 802.11" << m_standard);
+        }
+
+        if (m_manager == "minstrel") {
+            wifi.SetRemoteStationManager(IsHt() ? "ns3::MinstrelHtWifiManager" : "ns3::MinstrelWifiManager",
+                                         "RtsCtsThreshold", UintegerValue(m_rtsCtsThreshold));
+            return;
+        }
+
+        std::string dataMode = m_dataMode;
+        if (m_standard == "g") {
+            dataMode = dataMode.empty() ? "ErpOfdmRate54Mbps" : dataMode;
+        } else if (m_standard == "ac") {
+            // VhtMcs9 is not allowed for a single stream on 20 MHz channels
+            dataMode = dataMode.empty() ? "VhtMcs8" : dataMode;
+        } else {
+            dataMode = dataMode.empty() ? "HtMcs7" : dataMode;
+        }
+        wifi.SetRemoteStationManager("ns3::ConstantRateWifiManager",
+                                     "DataMode", StringValue(dataMode),
+                                     "ControlMode", StringValue(GetControlMode()),
+                                     "RtsCtsThreshold", UintegerValue(m_rtsCtsThreshold));
+    }
+
+    void
+    WifiStandardHelper::ConfigureDevices(NetDeviceContainer devices) const {
+        for (uint32_t i = 0; i < devices.GetN(); ++i) {
+            Ptr<WifiNetDevice> device = DynamicCast<WifiNetDevice>(devices.Get(i));
+            NS_ASSERT_MSG (device, "WifiStandardHelper can only configure WifiNetDevices");
+            device->GetPhy()->SetAttribute("ChannelWidth", UintegerValue(GetChannelWidth()));
+            if (IsHt()) {
+                device->GetMac()->SetAttribute("BE_MaxAmpduSize", UintegerValue(m_maxAmpduSize));
+                device->GetMac()->SetAttribute("BE_MaxAmsduSize", UintegerValue(m_maxAmsduSize));
+            }
+        }
+    }
+
+    uint16_t
+    WifiStandardHelper::GetChannelNumber(uint32_t index) const {
+        static const uint16_t channels24[] = {1, 6, 11};
+        static const uint16_t channels20[] = {36, 40, 44, 48};
+        static const uint16_t channels40[] = {38, 46, 54, 62};
+        static const uint16_t channels80[] = {42, 58, 106, 122};
+        static const uint16_t channels160[] = {50, 114};
+
+        uint16_t width = GetChannelWidth();
+        if (GetFrequency() < 5e9) {
+            if (width != 20) {
+                NS_FATAL_ERROR("Multiple channels on 2.4 GHz are only supported with 20 MHz channels");
+            }
+            return channels24[index % 3];
+        }
+        switch (width) {
+            case 20:
+                return channels20[index % 4];
+            case 40:
+                return channels40[index % 4];
+            case 80:
+                return channels80[index % 4];
+            default:
+                return channels160[index % 2];
+        }
+    }
+
+    void
+    WifiStandardHelper::SetChannel(NetDeviceContainer devices, uint32_t index) const {
+        uint16_t channel = GetChannelNumber(index);
+        for (uint32_t i = 0; i < devices.GetN(); ++i) {
+            Ptr<WifiNetDevice> device = DynamicCast<WifiNetDevice>(devices.Get(i));
+            NS_ASSERT_MSG (device, "WifiStandardHelper can only configure WifiNetDevices");
+            device->GetPhy()->SetChannelNumber(channel);
+        }
+    }
+
+    void
+    WifiStandardHelper::PrintJson(std::ostream &os) const {
+        os << "{";
+        os << "\"standard\":\"" << m_standard << "\",";
+        os << "\"channel_width\":" << GetChannelWidth() << ",";
+        os << "\"max_ampdu_size\":" << (IsHt() ? m_maxAmpduSize : 0) << ",";
+        os << "\"max_amsdu_size\":" << (IsHt() ? m_maxAmsduSize : 0) << ",";
+        os << "\"rate_manager\":\"" << m_manager << "\",";
+        os << "\"rts_cts_threshold\":" << m_rtsCtsThreshold;
+        os << "}";
+    }
+
+} // namespace ns3
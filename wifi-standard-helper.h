@@ -0,0 +1,139 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef WIFI_STANDARD_HELPER_H
+#define WIFI_STANDARD_HELPER_H
+
+#include <ostream>
+#include <string>
+#include "ns3/wifi-helper.h"
+#include "ns3/net-device-container.h"
+
+namespace ns3 {
+
+/**
+ * \brief Configure the wifi standard, channel width, frame aggregation and rate control of the simulations.
+ *
+ * Supported standards are "g" (802.11g, 2.4 GHz), "n-2.4" and "n-5" (802.11n at 2.4 GHz or 5 GHz)
+ * and "ac" (802.11ac, 5 GHz). The rate control is either "minstrel" (MinstrelWifiManager for 802.11g,
+ * MinstrelHtWifiManager for 802.11n/ac) or "constant" (ConstantRateWifiManager using the given data mode).
+ *
+ * Aggregation is only used by the HT/VHT standards, 802.11g devices ignore it.
+ */
+    class WifiStandardHelper {
+    public:
+        WifiStandardHelper();
+
+        /**
+         * \param standard g, n-2.4, n-5 or ac
+         */
+        void SetStandard(std::string standard);
+
+        /**
+         * \param width the channel width in MHz; 0 selects the default of the standard (20 MHz, 80 MHz for 802.11ac)
+         */
+        void SetChannelWidth(uint16_t width);
+
+        /**
+         * \param maxAmpduSize maximum size of an A-MPDU in bytes, 0 disables A-MPDU aggregation
+         * \param maxAmsduSize maximum size of an A-MSDU in bytes, 0 disables A-MSDU aggregation
+         */
+        void SetAggregation(uint32_t maxAmpduSize, uint32_t maxAmsduSize);
+
+        /**
+         * \param manager minstrel or constant
+         * \param dataMode the data mode used by the constant rate manager; empty selects the fastest
+         *                 single stream mode of the standard (ErpOfdmRate54Mbps, HtMcs7 or VhtMcs8)
+         */
+        void SetRateManager(std::string manager, std::string dataMode);
+
+        /**
+         * \param threshold frames larger than this many bytes are protected by RTS/CTS;
+         *                  0 protects all frames, 65535 (the default) none
+         */
+        void SetRtsCtsThreshold(uint32_t threshold);
+
+        /**
+         * Set the standard and the remote station manager. Must be called before the devices are installed.
+         *
+         * \param wifi the helper used to install the devices
+         */
+        void Configure(WifiHelper &wifi) const;
+
+        /**
+         * Set the channel width and the aggregation limits. Must be called after the devices were installed,
+         * as WifiHelper::Install resets them to the defaults of the standard.
+         *
+         * \param devices the wifi devices
+         */
+        void ConfigureDevices(NetDeviceContainer devices) const;
+
+        /**
+         * Tune the devices to one of the non-overlapping channels of the standard. Must be called after
+         * ConfigureDevices, as the available channels depend on the channel width.
+         *
+         * \param devices the wifi devices
+         * \param index the index of the channel, counted modulo the number of non-overlapping channels
+         */
+        void SetChannel(NetDeviceContainer devices, uint32_t index) const;
+
+        /**
+         * \return the carrier frequency in Hz, to be used by the propagation loss model
+         */
+        double GetFrequency(void) const;
+
+        /**
+         * \return the channel width to use in MHz
+         */
+        uint16_t GetChannelWidth(void) const;
+
+        /**
+         * \return the most robust mode of the standard (ErpOfdmRate6Mbps, HtMcs0 or VhtMcs0), used for the
+         *         control frames and as the lowest rate of minstrel
+         */
+        std::string GetControlMode(void) const;
+
+        /**
+         * Print the configuration as JSON object.
+         *
+         * \param os the stream to print to
+         */
+        void PrintJson(std::ostream &os) const;
+
+    private:
+        /**
+         * \return true if the standard is 802.11n or 802.11ac
+         */
+        bool IsHt(void) const;
+
+        /**
+         * \param index the index of the channel
+         * \return the channel number of the index-th non-overlapping channel
+         */
+        uint16_t GetChannelNumber(uint32_t index) const;
+
+        std::string m_standard;     //!< Name of the standard
+        uint16_t m_channelWidth;    //!< Channel width in MHz, 0 for the default
+        uint32_t m_maxAmpduSize;    //!< Maximum A-MPDU size in bytes
+        uint32_t m_maxAmsduSize;    //!< Maximum A-MSDU size in bytes
+        std::string m_manager;      //!< Name of the rate control
+        std::string m_dataMode;     //!< Data mode of the constant rate manager
+        uint32_t m_rtsCtsThreshold; //!< RTS/CTS threshold in bytes
+    };
+
+} // namespace ns3
+
+#endif /* WIFI_STANDARD_HELPER_H */